@@ -1,5 +1,7 @@
-from ._scipywrapper import biteopt, OptimizeResult, __source_version__
+from ._scipywrapper import biteopt, engine_stats, read_eval_log, OptimizeResult, __source_version__
 
 __all__ = ["biteopt",
+        "engine_stats",
+        "read_eval_log",
         "OptimizeResult",
         "__source_version__"]
\ No newline at end of file
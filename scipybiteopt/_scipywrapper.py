@@ -1,5 +1,7 @@
-from .biteopt import _minimize
+from .biteopt import _minimize, _engine_stats
 import numpy as np
+import os
+import struct
 
 __source_version__ = "2021.28.1"
 
@@ -32,13 +34,20 @@ class OptimizeResult(dict):
         else:
             return self.__class__.__name__ + "()"
 
-def biteopt(fun, bounds, args=(), iters = 20000, depth = 1, attempts = 1, tol = 'hard', callback = None):
+def biteopt(fun, bounds, args=(), iters = 20000, depth = 1, attempts = 1, tol = 'hard', callback = None,
+            callback_evals = 1000, callback_time = None, seed = None, cache_size = 0,
+            cache_file = None, cache_tag = None, prescreen = False, cost_bound = False,
+            delta_fun = None, constraints = (), n_objectives = 1, ftol = None, xtol = None,
+            polish_iters = 0, var_types = None, gen_stats = False, trace_file = None,
+            eval_log = None, maxtime = None, f_target = None, fast_rng = False):
     '''
     Global optimization via the biteopt algorithm
 
     .. note::
-        biteopt does not handle Python Exceptions and will not exit gracefully in case of errors. 
-        Take care that your objective function always returns a double. 
+        An exception raised by ``fun``, ``delta_fun``, a constraint or ``callback``, and a
+        ``KeyboardInterrupt`` (Ctrl-C), stops the optimization after the current iteration
+        and is re-raised; its ``result`` attribute then holds the :py:class:`~OptimizeResult`
+        with the best solution found so far (without ``maxcv``). ``fun`` must return a number.
 
     Parameters
     ----------
@@ -65,11 +74,123 @@ def biteopt(fun, bounds, args=(), iters = 20000, depth = 1, attempts = 1, tol =
         Stops optimization if no significant decrease of the objective function was achieved within 
         a certain number of iterations: 64*n_dim for ``hard``, 128*n_dim for ``weak``. If ``None``, optimization 
         will run for the maximal number of function evaluations ``iter`` per attempt.
+        Applies independently of ``ftol`` and ``xtol``.
+    maxtime : float, optional, default None
+        Wall-clock time budget in seconds, for all attempts and the polishing phase. When it
+        runs out, the optimization stops after the objective function evaluation in
+        progress, and the best solution found so far is returned. Evaluations are not
+        interrupted, so the budget may be exceeded by about one evaluation's duration.
+    f_target : float, optional, default None
+        Target value: the optimization stops as soon as a solution with ``fun`` less or equal
+        to ``f_target`` is found. Cannot be combined with ``n_objectives>1``.
+    ftol : float, optional, default None
+        Relative cost tolerance. An attempt is stopped once the spread of costs across the
+        population, relative to their magnitude, falls to ``ftol`` or below. Checked once
+        per population turnover. Ignored if ``n_objectives>1``.
+    xtol : float, optional, default None
+        Parameter tolerance. An attempt is stopped once every parameter of every population
+        member is within ``xtol`` of the population's centroid, relative to the parameter's
+        range ``max-min``. If both ``ftol`` and ``xtol`` are given, both must be met.
+    polish_iters : int, optional, default 0
+        Maximal number of function evaluations of the local polishing phase. If ``>0``,
+        after all attempts a Nelder-Mead simplex search is started from the best solution
+        with a small radius, to refine its last digits. On smooth, well-conditioned problems
+        this needs fewer evaluations than continuing the global search. Polishing stops early after ``128*n_dim`` evaluations without
+        improvement. Not performed if ``n_objectives>1``.
+    var_types : sequence of str, optional, default None
+        Type of each variable: ``'continuous'``, ``'integer'`` or ``'categorical'``. Integer and
+        categorical variables are passed to ``fun`` as whole numbers within their bounds, each
+        value being equally likely to be sampled. A categorical variable holds a category index,
+        e.g. with bounds ``(0, k-1)`` for ``k`` categories; unlike integer variables, no order of
+        values is implied. Candidates equal to an already evaluated population member are
+        regenerated instead of being passed to ``fun``, so there is no need to round inside ``fun``.
+        If ``None``, all variables are continuous.
+    gen_stats : bool, optional, default False
+        If ``True``, statistics of the optimizer's solution generators are collected, to see
+        which generators are used on a problem, how often their candidates are accepted,
+        and how much time the optimizer itself spends in each of them.
+    trace_file : str, optional, default None
+        Path of a timeline file to write, in the Chrome trace event JSON format, which can
+        be opened in ``chrome://tracing`` or https://ui.perfetto.dev. The timeline shows
+        each attempt, solution generator, objective function evaluation, population update,
+        centroid recalculation, parallel optimizer step and restart, and the polishing phase,
+        per thread, so that the optimizer's overhead can be compared with the time spent
+        in ``fun``. Events are recorded into per-thread memory buffers, and the file is
+        written after the optimization.
+    eval_log : str, optional, default None
+        Path of a binary evaluation log to write. Every evaluation of ``fun`` is recorded
+        with its parameter vector, value, solution generator and time, see
+        :py:func:`~read_eval_log`. Records are written by a background thread, so logging
+        does not slow down the optimization like file I/O in ``fun`` would. Evaluations
+        served from ``cache_size`` or ``cache_file`` are not recorded, and ``n_objectives``
+        must be 1.
     callback : callable, optional, default None
-        callback function which is also called before every objective function evaluation. 
-        Must be in the form ``fun(x, *args)``, where ``x`` 
-        is the argument in the form of a 1-D numpy array and args is a tuple of any additional fixed 
-        parameters needed to completely specify the function.
+        Progress callback, called every ``callback_evals`` objective function evaluations or
+        every ``callback_time`` seconds, whichever comes first. Must be in the form
+        ``callback(intermediate_result)``, where ``intermediate_result`` is an
+        :py:class:`~OptimizeResult` with the attributes ``x``, the best solution found so
+        far, ``fun``, its value, ``nfev``, the number of evaluations so far, and ``stall``,
+        the number of evaluations without improvement. ``x`` is a read-only view that is only
+        valid during the call, and should be copied to be kept. If the callback returns
+        ``True``, the optimization is stopped, and the best solution found so far is returned.
+    callback_evals : int, optional, default 1000
+        Evaluation interval of ``callback`` calls, ``None`` to only use ``callback_time``.
+    callback_time : float, optional, default None
+        Time interval of ``callback`` calls, in seconds, ``None`` to only use ``callback_evals``.
+    seed : int, optional, default None
+        Random seed. If given, every attempt uses its own independent random stream
+        derived from ``seed`` and the attempt index, so results are reproducible and 
+        do not depend on the preceding attempts. If ``None``, the fixed legacy seed is used.
+    fast_rng : bool, optional, default False
+        If ``True``, the optimizer uses a buffered multi-lane random number generator,
+        which reduces the optimizer's own overhead on cheap objectives. It produces a
+        different random sequence, so results differ from the default generator, but
+        stay reproducible for a given ``seed``.
+    cache_size : int, optional, default 0
+        Size of the evaluation cache. If ``>0``, costs of up to ``cache_size`` recently evaluated
+        parameter vectors are kept, and exactly repeated vectors are not passed to ``fun`` again.
+        Covers all candidates of the global phase, including those of the initial population
+        and of the parallel optimizers, but not the polishing phase. Useful for expensive
+        objectives.
+    cache_file : str, optional, default None
+        Path of a persistent, memory-mapped evaluation store (POSIX systems only). Objective values
+        are stored in this file and reused by later runs on the same problem, i.e. with the same
+        number of variables, ``bounds`` and ``cache_tag``. The file can be shared by concurrent
+        processes. It is created if it does not exist. It holds up to 65536 values; when it is full,
+        stored values are evicted to make room for new ones.
+    cache_tag : str, optional, default None
+        User tag that identifies the objective function (and ``args``) within ``cache_file``.
+        Should be changed whenever the objective function changes.
+    prescreen : bool, optional, default False
+        If ``True``, the cost of every new candidate is first predicted from its nearest
+        neighbours among the already evaluated solutions. Candidates predicted to be worse than
+        the whole current population are discarded without calling ``fun`` (a random fraction of
+        them is still evaluated). Only useful for expensive objectives.
+    cost_bound : bool, optional, default False
+        If ``True``, ``fun`` is called as ``fun(x, *args, cost_bound=bound)``, where ``bound`` is
+        the cost above which ``x`` will be rejected (``inf`` if there is no bound). Objectives that
+        accumulate their cost incrementally may stop as soon as the cost exceeds ``bound``, and
+        return any value above ``bound``, e.g. the partial cost. Such results are not cached.
+    delta_fun : callable, optional, default None
+        Delta-evaluation form of ``fun``: ``delta_fun(x, parent_x, parent_f, changed, *args)``.
+        Called instead of ``fun`` when ``x`` was produced from an already evaluated solution
+        ``parent_x`` with the value ``parent_f`` by changing only the coordinates listed in
+        the integer array ``changed``. Objectives that are sums of per-variable terms can then
+        be updated in O(len(changed)) time. ``fun`` is still called for other solutions, and for
+        solutions whose parent is infeasible, or has a value of 1e200 and above (e.g. NaN).
+        Cannot be combined with ``cost_bound``.
+    constraints : dict or sequence of dict, optional, default ()
+        Inequality constraints in the scipy format: dicts with the fields ``type`` (must be
+        ``'ineq'``), ``fun`` and optionally ``args``. A constraint is satisfied if
+        ``fun(x, *args) >= 0`` (scalar or array-like). Constraints are evaluated before the
+        objective; ``fun`` is not called for infeasible ``x``, such solutions are ranked by their
+        total constraint violation, and any feasible solution is preferred over any infeasible one.
+        Constraint functions should be cheap.
+    n_objectives : int, optional, default 1
+        Number of objectives. If ``>1``, ``fun`` must return an array-like of ``n_objectives``
+        values, which are minimized simultaneously, and the Pareto front of non-dominated
+        solutions is searched for. Cannot be combined with ``cache_size``, ``cache_file``,
+        ``prescreen``, ``cost_bound`` and ``delta_fun``.
 
     Returns
     -------
@@ -77,6 +198,37 @@ def biteopt(fun, bounds, args=(), iters = 20000, depth = 1, attempts = 1, tol =
         The optimization result represented as a :py:class:`~OptimizeResult` object.
         Attributes are: ``x`` the solution array, ``fun`` the value
         of the function at the solution, and the number of function evaluations ``nfev``.
+        ``nfev`` also counts evaluations served from the cache or the persistent store;
+        ``fun_calls`` holds the number of actual ``fun`` (or ``delta_fun``) calls.
+        If ``cache_size>0``, ``cache_hits`` and ``cache_misses`` hold the number of
+        evaluations served from the cache, and the number of cache lookups that were
+        passed on for evaluation, of the global phase. The polishing phase is not cached.
+        If ``cache_file`` is given, ``store_hits`` and ``store_misses`` hold the same
+        statistics for the persistent store.
+        If ``prescreen`` is ``True``, ``prescreen_saved`` holds the number of
+        candidates that were discarded without evaluation.
+        If ``cost_bound`` is ``True``, ``bound_exceeded`` holds the number of
+        evaluations that returned a value above the bound.
+        If ``delta_fun`` is given, ``delta_evals`` holds the number of its calls.
+        If ``var_types`` is given, ``dup_saved`` holds the number of duplicate candidates
+        that were not evaluated.
+        If ``gen_stats`` is ``True``, ``gen_stats`` holds a dict keyed by generator name,
+        each value being a dict with the number of times the generator was ``selected``,
+        the number of its candidates ``accepted`` into the population, ``rank_hist``, a
+        list of 8 counts of accepted candidates by population rank (best ranks first),
+        and ``ticks`` spent in the generator; ``eval_ticks`` holds ticks spent in ``fun``.
+        Ticks are CPU timestamp counter cycles on x86, nanoseconds otherwise.
+        If ``polish_iters>0``, ``nfev_global`` and ``nfev_polish`` hold the number of
+        function evaluations of the global and the polishing phase; ``nfev`` is their sum.
+        If ``callback`` is given, ``callback_stop`` is ``True`` if it stopped the optimization.
+        If ``maxtime`` is given, ``time_stop`` is ``True`` if the time budget ran out.
+        If ``constraints`` are given, ``maxcv`` holds the maximal constraint violation
+        at the solution; if it is above zero, no feasible solution was found, and ``fun``
+        is a violation-based value of at least 1e200.
+        If ``n_objectives>1``, ``pareto_x`` and ``pareto_fun`` hold the non-dominated
+        feasible solutions found (up to 256), and their objective values, as 2-D arrays;
+        ``x`` is the first solution of the front, and ``fun`` holds its objective values
+        (if no feasible solution was found, ``fun`` is a violation-based rank instead).
 
     Example
     --------
@@ -132,23 +284,260 @@ def biteopt(fun, bounds, args=(), iters = 20000, depth = 1, attempts = 1, tol =
     if not isinstance(args, tuple):
         raise ValueError("'args' must be between of type list.")
 
+    if seed is not None:
+        if not isinstance(seed, int):
+            raise ValueError("'seed' must be of type integer.")
+        if seed < 0:
+            raise ValueError("'seed' must be >=0.")
+
+    if not isinstance(cache_size, int):
+        raise ValueError("'cache_size' must be of type integer.")
+    if cache_size < 0:
+        raise ValueError("'cache_size' must be >=0.")
+
+    if cache_file is not None and not isinstance(cache_file, str):
+        raise ValueError("'cache_file' must be of type string.")
+    if cache_tag is not None and not isinstance(cache_tag, str):
+        raise ValueError("'cache_tag' must be of type string.")
+    if trace_file is not None and not isinstance(trace_file, str):
+        raise ValueError("'trace_file' must be of type string.")
+    if eval_log is not None and not isinstance(eval_log, str):
+        raise ValueError("'eval_log' must be of type string.")
+
+    if not isinstance(prescreen, bool):
+        raise ValueError("'prescreen' must be of type bool.")
+    if not isinstance(cost_bound, bool):
+        raise ValueError("'cost_bound' must be of type bool.")
+    if delta_fun is not None:
+        if not callable(delta_fun):
+            raise ValueError("'delta_fun' must be callable.")
+        if cost_bound:
+            raise ValueError("'delta_fun' cannot be combined with 'cost_bound'.")
+
+    if not isinstance(n_objectives, int):
+        raise ValueError("'n_objectives' must be of type integer.")
+    if n_objectives < 1:
+        raise ValueError("'n_objectives' must be >=1.")
+    if n_objectives > 1 and (cache_size > 0 or cache_file is not None or prescreen or
+                             cost_bound or delta_fun is not None or eval_log is not None or
+                             f_target is not None):
+        raise ValueError("'n_objectives>1' cannot be combined with caching, 'prescreen', "
+                         "'cost_bound', 'delta_fun', 'eval_log' or 'f_target'.")
+
+    if not isinstance(polish_iters, int):
+        raise ValueError("'polish_iters' must be of type integer.")
+    if polish_iters < 0:
+        raise ValueError("'polish_iters' must be >=0.")
+
+    if callback is not None and not callable(callback):
+        raise ValueError("'callback' must be callable.")
+    if callback_evals is not None:
+        if not isinstance(callback_evals, int):
+            raise ValueError("'callback_evals' must be of type integer.")
+        if callback_evals < 1:
+            raise ValueError("'callback_evals' must be >=1.")
+    if callback_time is not None:
+        if not isinstance(callback_time, (int, float)):
+            raise ValueError("'callback_time' must be a number.")
+        if callback_time <= 0:
+            raise ValueError("'callback_time' must be >0.")
+    if callback is not None and callback_evals is None and callback_time is None:
+        raise ValueError("'callback_evals' and 'callback_time' cannot both be None.")
+
+    if maxtime is not None:
+        if not isinstance(maxtime, (int, float)):
+            raise ValueError("'maxtime' must be a number.")
+        if maxtime <= 0:
+            raise ValueError("'maxtime' must be >0.")
+    if f_target is not None and not isinstance(f_target, (int, float)):
+        raise ValueError("'f_target' must be a number.")
+
+    for name, value in (('ftol', ftol), ('xtol', xtol)):
+        if value is not None:
+            if not isinstance(value, (int, float)):
+                raise ValueError("'%s' must be a number." % name)
+            if value <= 0:
+                raise ValueError("'%s' must be >0." % name)
+
+    types = None
+    if var_types is not None:
+        type_codes = {'continuous': 0, 'integer': 1, 'categorical': 2}
+        if len(var_types) != len(lower_bounds):
+            raise ValueError("'var_types' must have the same length as 'bounds'.")
+        for t in var_types:
+            if t not in type_codes:
+                raise ValueError("'var_types' entries must be one of 'continuous', 'integer', 'categorical'.")
+        types = [type_codes[t] for t in var_types]
+        for t, lb, ub in zip(types, lower_bounds, upper_bounds):
+            if t != 0 and np.floor(ub) < np.ceil(lb):
+                raise ValueError("bounds of integer and categorical variables must include an integer.")
+
+    if isinstance(constraints, dict):
+        constraints = (constraints,)
+    for con in constraints:
+        if not isinstance(con, dict) or 'fun' not in con:
+            raise ValueError("'constraints' must be a dict or a sequence of dicts with a 'fun' field.")
+        if con.get('type', 'ineq') != 'ineq':
+            raise ValueError("only 'ineq' constraints are supported.")
+
     #generate wrapper function which passes args to the objective
 
+    def wrapped_fun(x, **kwargs):
+
+        return fun(x, *args, **kwargs)
+
+    wrapped_delta = None
+
+    if delta_fun is not None:
+
+        def wrapped_delta(x, parent_x, parent_f, changed):
+
+            return delta_fun(x, parent_x, parent_f, changed, *args)
+
+    wrapped_progress = None
+
     if callback is not None:
 
-        def wrapped_fun(x):
-            
-            callback(x)
-            return fun(x, *args)
-    
-    else:
+        def wrapped_progress(x, f, nfev, stall):
 
-        def wrapped_fun(x):
-        
-            return fun(x, *args)
+            return bool(callback(OptimizeResult(x=x, fun=f, nfev=nfev, stall=stall)))
     
-    f, x_opt, n_eval = _minimize(wrapped_fun, lower_bounds, upper_bounds, iters, depth, attempts, tol_c)
+    wrapped_cns = None
+    n_cns = 0
+
+    if len(constraints) > 0:
+
+        def wrapped_cns(x):
+
+            # convert g(x) >= 0 to c(x) <= 0
+            return -np.concatenate([np.atleast_1d(np.asarray(con['fun'](x, *con.get('args', ())), dtype=float))
+                                    for con in constraints])
+
+        n_cns = len(wrapped_cns(0.5 * (np.asarray(lower_bounds, dtype=float) +
+                                       np.asarray(upper_bounds, dtype=float))))
+
+    def make_result(f, x_opt, n_eval, info):
+
+        result = OptimizeResult(x=x_opt, fun = f, nfev=n_eval)
+        result.update(info)
+        if n_objectives > 1 and len(result.pareto_x) > 0:
+            result.x = result.pareto_x[0].copy()
+            result.fun = result.pareto_fun[0].copy()
+        return result
+
+    try:
+        f, x_opt, n_eval, info = _minimize(wrapped_fun, lower_bounds, upper_bounds, iters, depth, attempts, tol_c, seed,
+                                           cache_size, cache_file, cache_tag, int(prescreen),
+                                           int(cost_bound), wrapped_delta, wrapped_cns, n_cns, n_objectives,
+                                           float(ftol or 0.0), float(xtol or 0.0), polish_iters, types,
+                                           int(gen_stats), trace_file, eval_log,
+                                           wrapped_progress, int(callback_evals or 0), float(callback_time or 0.0),
+                                           float(maxtime or 0.0), f_target, int(fast_rng))
+    except BaseException as e:
+        # the extension attaches the best solution found before the error
+        partial = getattr(e, '_biteopt_result', None)
+        if partial is not None:
+            del e._biteopt_result
+            e.result = make_result(*partial)
+        raise
 
-    result = OptimizeResult(x=x_opt, fun = f, nfev=n_eval)
+    result = make_result(f, x_opt, n_eval, info)
+    if wrapped_cns is not None:
+        result.maxcv = float(max(0.0, np.max(wrapped_cns(x_opt))))
     
-    return result
\ No newline at end of file
+    return result
+
+def engine_stats(reset=False):
+    '''
+    Hot-path counters of the optimizer's population engine
+
+    Counters are only available if the extension was built with the ``BITEOPT_STATS``
+    environment variable set, e.g. ``BITEOPT_STATS=1 pip install .``; they compile away
+    otherwise. Counters are kept per thread, and accumulate over all ``biteopt`` calls
+    made by the calling thread.
+
+    Parameters
+    ----------
+    reset : bool, optional, default False
+        If ``True``, counters are reset to zero after they were read.
+
+    Returns
+    -------
+    stats : dict or None
+        ``None`` if counters are not compiled in. Otherwise a dict with the number of
+        objective function evaluations ``evals``, PRNG draws ``rnd_draws``, population
+        update calls ``update_pop_calls``, rejections ``update_pop_rejects`` and equal-cost
+        replacements ``update_pop_replaces``, the total distance of population list shifts
+        ``move_dist``, full centroid recalculations ``centroid_recomputes``, centroid
+        distance calculations ``centroid_dist_calls``, and out-of-range parameter values
+        wrapped ``wrap_hits``.
+    '''
+
+    return _engine_stats(int(reset))
+
+def read_eval_log(path, pop_size=None):
+    '''
+    Replay of an evaluation log written by ``biteopt(..., eval_log=path)``
+
+    Parameters
+    ----------
+    path : str
+        Path of the log file.
+    pop_size : int, optional, default None
+        Population size for the population reconstruction; if ``None``, the optimizer's
+        population size stored in the log is used.
+
+    Returns
+    -------
+    log : :py:class:`~OptimizeResult`
+        Attributes are: ``x`` the evaluated parameter vectors as a read-only memory-mapped
+        2-D array, ``fun`` their values, ``gen`` the solution generator indices into
+        ``gen_names`` (-1 for initial population evaluations, -2 for the polishing phase),
+        ``attempt`` the attempt indices, and ``time`` the evaluation end times in seconds
+        since the start of the optimization. Records are in the order they were
+        written. ``best_fun`` is the best-so-far curve, i.e. the lowest value among the
+        records up to each record; ``best_x`` and ``best`` hold the best parameter vector
+        and its value. NaN values are ignored by these, unless all values are NaN. ``pop_x`` and ``pop_fun`` reconstruct the population at the end of
+        the last attempt, as its ``pop_size`` best evaluated vectors, best first; with
+        ``depth>1`` this merges the populations of all optimizers of the attempt.
+    '''
+
+    with open(path, 'rb') as fh:
+        head = fh.read(32)
+        if len(head) < 32 or head[:8] != b'BITELOG1':
+            raise ValueError("'%s' is not an evaluation log." % path)
+        header_size, rec_size, n, log_pop_size, gen_count, _ = struct.unpack('=6I', head[8:])
+        gen_names = [name.decode() for name in fh.read(header_size - 32).split(b'\0')[:gen_count]]
+
+    dtype = np.dtype([('time', '=i8'), ('gen', '=i4'), ('attempt', '=i4'), ('fun', '=f8'),
+                      ('x', '=f8', (n,))])
+    if dtype.itemsize != rec_size:
+        raise ValueError("'%s' has an unsupported record format." % path)
+
+    # a partially written last record is ignored
+    count = (os.path.getsize(path) - header_size) // rec_size
+    if count > 0:
+        rec = np.memmap(path, dtype=dtype, mode='r', offset=header_size, shape=(count,))
+    else:
+        rec = np.zeros(0, dtype=dtype)
+
+    fun = np.asarray(rec['fun'])
+    result = OptimizeResult(x=rec['x'], fun=fun, gen=np.asarray(rec['gen']),
+                            attempt=np.asarray(rec['attempt']), time=rec['time'] * 1e-9,
+                            gen_names=gen_names)
+    # NaN values, as returned by ``fun``, are skipped by the best-so-far statistics
+    result.best_fun = np.fmin.accumulate(fun) if count > 0 else fun.copy()
+
+    if count > 0:
+        ib = int(np.argmin(np.where(np.isnan(fun), np.inf, fun)))
+        result.best_x = np.array(rec['x'][ib])
+        result.best = float(fun[ib])
+
+        last = np.flatnonzero((result.attempt == result.attempt[-1]) & (result.gen != -2))
+        if pop_size is None:
+            pop_size = log_pop_size if log_pop_size > 0 else len(last)
+        ip = last[np.argsort(fun[last], kind='stable')[:pop_size]]
+        result.pop_x = np.array(rec['x'][ip])
+        result.pop_fun = fun[ip].copy()
+
+    return result
@@ -37,6 +37,74 @@
 #include <stdint.h>
 #include <math.h>
 #include <string.h>
+#include <stdio.h>
+#include <atomic>
+#include <chrono>
+
+#if defined( _MSC_VER ) && ( defined( _M_X64 ) || defined( _M_IX86 ))
+	#include <intrin.h>
+	#define BITEOPT_RDTSC 1
+#elif defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ))
+	#include <x86intrin.h>
+	#define BITEOPT_RDTSC 1
+#endif // x86
+
+#if defined( BITEOPT_STATS )
+
+/**
+ * Hot-path counters of the population engine, compiled in if the
+ * BITEOPT_STATS macro is defined. Counters are kept per thread, and are
+ * updated via the BITEOPT_STAT() macro, which compiles to nothing
+ * otherwise.
+ */
+
+struct CBiteStats
+{
+	int64_t EvalCount; ///< The number of CBiteOpt's objective function
+		///< evaluations, including parallel optimizers' ones.
+	int64_t RndDraws; ///< The number of 64-bit PRNG values drawn.
+	int64_t UpdatePopCalls; ///< The number of CBitePop::updatePop() calls.
+	int64_t UpdatePopRejects; ///< The number of solutions rejected by
+		///< updatePop(), due to a cost above the worst one.
+	int64_t UpdatePopReplaces; ///< The number of equal-cost replacements
+		///< made by updatePop().
+	int64_t MoveDist; ///< The total distance, in elements, of ordered list
+		///< shifts made by updatePop().
+	int64_t CentRecomputes; ///< The number of full centroid
+		///< recalculations, via CBitePop::updateCentroid().
+	int64_t CentDistCalls; ///< The number of
+		///< CBiteParPops::calcCentroidDists() calls.
+	int64_t WrapHits; ///< The number of out-of-range values wrapped by the
+		///< wrapParam() function.
+
+	/**
+	 * @return Counters of the calling thread.
+	 */
+
+	static CBiteStats& get()
+	{
+		static thread_local CBiteStats s;
+
+		return( s );
+	}
+
+	/**
+	 * Function resets all counters to zero.
+	 */
+
+	void clear()
+	{
+		memset( this, 0, sizeof( *this ));
+	}
+};
+
+#define BITEOPT_STAT( c, v ) ( CBiteStats :: get().c += ( v ))
+
+#else // defined( BITEOPT_STATS )
+
+#define BITEOPT_STAT( c, v ) ( (void) 0 )
+
+#endif // defined( BITEOPT_STATS )
 
 /**
  * Type for an externally-provided random number generator, to be used instead
@@ -53,11 +121,24 @@ typedef uint32_t( *biteopt_rng )( void* rng_data );
  * Class that implements a pseudo-random number generator (PRNG). The default
  * implementation includes a fast high-quality PRNG (2^159 period). See
  * https://github.com/avaneev/prvhash for more details.
+ *
+ * Besides the default (legacy) serial generator, the class implements a
+ * buffered multi-lane generator that runs several independent PRNG lanes at
+ * once, in a form that is friendly to SIMD auto-vectorization. The
+ * multi-lane mode produces a different sequence, and is enabled via the
+ * init() and initStream() functions; the legacy mode stays bit-exact. The
+ * fill*() functions produce the same values as the sequential scalar calls
+ * in both modes.
  */
 
 class CBiteRnd
 {
 public:
+	static const int LaneCount = 4; ///< The number of PRNG lanes used by the
+		///< multi-lane generator.
+	static const int LaneBufLen = 64; ///< The length of the multi-lane
+		///< generator's output buffer, a multiple of LaneCount.
+
 	/**
 	 * Default constructor, calls the init() function.
 	 */
@@ -78,6 +159,18 @@ public:
 		init( NewSeed );
 	}
 
+	/**
+	 * Constructor, calls the initStream() function.
+	 *
+	 * @param NewSeed Random seed value.
+	 * @param StreamId Stream identifier.
+	 */
+
+	CBiteRnd( const uint64_t NewSeed, const uint64_t StreamId )
+	{
+		initStream( NewSeed, StreamId );
+	}
+
 	/**
 	 * Function initializes *this PRNG object.
 	 *
@@ -85,10 +178,13 @@ public:
 	 * @param arf External random number generator to use; NULL: use the
 	 * default PRNG. Note that the external RNG should be seeded externally.
 	 * @param ardata Data pointer to pass to the "arf" function.
+	 * @param aUseLanes "True" if the buffered multi-lane generator should be
+	 * used instead of the legacy serial generator. Ignored, if "arf" is
+	 * non-NULL.
 	 */
 
 	void init( const int NewSeed, biteopt_rng const arf = NULL,
-		void* const ardata = NULL )
+		void* const ardata = NULL, const bool aUseLanes = false )
 	{
 		rf = arf;
 		rdata = ardata;
@@ -97,6 +193,7 @@ public:
 		Seed = (uint64_t) NewSeed;
 		lcg = 0;
 		Hash = 0;
+		UseLanes = false;
 
 		// Skip first values to make PRNG "settle down".
 
@@ -106,6 +203,62 @@ public:
 		{
 			advance();
 		}
+
+		if( aUseLanes && arf == NULL )
+		{
+			initLanes();
+		}
+	}
+
+	/**
+	 * Function initializes *this PRNG object to produce a sub-stream of the
+	 * specified seed. The whole PRNG state is derived from the seed and
+	 * stream identifier via a bijective mixing function, so that each
+	 * (seed, stream) pair produces its own reproducible sequence. Given the
+	 * 2^159 period, sequences of distinct streams are statistically
+	 * independent, and do not overlap at any practical length. This makes
+	 * it possible to assign streams to threads, attempts, or batch lanes,
+	 * without correlating their outcomes, and without depending on the order
+	 * of their execution.
+	 *
+	 * @param NewSeed Random seed value.
+	 * @param StreamId Stream identifier, e.g., a thread or attempt index.
+	 * @param aUseLanes "True" if the buffered multi-lane generator should be
+	 * used.
+	 */
+
+	void initStream( const uint64_t NewSeed, const uint64_t StreamId,
+		const bool aUseLanes = false )
+	{
+		rf = NULL;
+		rdata = NULL;
+
+		BitsLeft = 0;
+		Seed = mix64( NewSeed );
+		lcg = mix64( StreamId ^ 0x5555555555555555 );
+		Hash = mix64( Seed ^ lcg ^ 0xAAAAAAAAAAAAAAAA );
+		UseLanes = false;
+
+		int i;
+
+		for( i = 0; i < 5; i++ )
+		{
+			advance();
+		}
+
+		if( aUseLanes )
+		{
+			initLanes();
+		}
+	}
+
+	/**
+	 * Function returns "true" if the multi-lane generator is in use.
+	 */
+
+	bool getUseLanes() const
+	{
+		return( UseLanes );
 	}
 
 	/**
@@ -147,8 +300,20 @@ public:
 
 	double getPow( const double p )
 	{
-		const double v = ( advance() >> ( 64 - 53 )) * 0x1p-53;
+		return( calcPow(( advance() >> ( 64 - 53 )) * 0x1p-53, p ));
+	}
+
+	/**
+	 * Function raises the specified value to the specified power, with
+	 * branching for optimization. This function defines results of the
+	 * getPow() function.
+	 *
+	 * @param v Value in the range [0; 1].
+	 * @param p Power factor.
+	 */
 
+	static double calcPow( const double v, const double p )
+	{
 		if( p < 2.0 )
 		{
 			if( p < 1.0 )
@@ -321,6 +486,76 @@ public:
 		return( v / u );
 	}
 
+	/**
+	 * Function fills the specified array with random numbers in the range
+	 * [0; 1). Produces the same values as sequential get() calls.
+	 *
+	 * @param[out] p Output array.
+	 * @param n The number of values to produce.
+	 */
+
+	void fillUniform( double* const p, const int n )
+	{
+		int i;
+
+		if( !UseLanes )
+		{
+			for( i = 0; i < n; i++ )
+			{
+				p[ i ] = get();
+			}
+
+			return;
+		}
+
+		i = 0;
+
+		while( i < n )
+		{
+			if( LanePos == LaneBufLen )
+			{
+				refillLanes();
+			}
+
+			const int c = ( LaneBufLen - LanePos < n - i ?
+				LaneBufLen - LanePos : n - i );
+
+			const uint64_t* const lb = LaneBuf + LanePos;
+			double* const op = p + i;
+			int k;
+
+			for( k = 0; k < c; k++ )
+			{
+				op[ k ] = ( lb[ k ] >> ( 64 - 53 )) * 0x1p-53;
+			}
+
+			LanePos += c;
+			i += c;
+
+			BITEOPT_STAT( RndDraws, c );
+		}
+	}
+
+	/**
+	 * Function fills the specified array with Gaussian-distributed random
+	 * numbers with mean=0 and std.dev=1. Produces the same values as
+	 * sequential getGaussian() calls. The rejection sampling itself is
+	 * sequential, but in the multi-lane mode it draws from the lane buffer.
+	 *
+	 * @param[out] p Output array.
+	 * @param n The number of values to produce.
+	 */
+
+	void fillGaussian( double* const p, const int n )
+	{
+		int i;
+
+		for( i = 0; i < n; i++ )
+		{
+			p[ i ] = getGaussian();
+		}
+	}
+
 	/**
 	 * Function returns the next random bit, usually used for 50% probability
 	 * evaluations efficiently.
@@ -348,6 +583,25 @@ public:
 		return( b );
 	}
 
+	/**
+	 * A bijective 64-bit mixing function ("moremur" finalizer), used to
+	 * derive PRNG state from seed and stream identifier values, and for
+	 * hashing.
+	 *
+	 * @param v Value to mix.
+	 */
+
+	static uint64_t mix64( uint64_t v )
+	{
+		v ^= v >> 27;
+		v *= 0x3C79AC492BA7B653;
+		v ^= v >> 33;
+		v *= 0x1C69B3F74AC4AE35;
+		v ^= v >> 27;
+
+		return( v );
+	}
+
 protected:
 	biteopt_rng rf; ///< External random number generator to use; NULL: use
 		///< the default PRNG.
@@ -355,6 +609,86 @@ protected:
 	uint64_t Seed, lcg, Hash; ///< PRNG state variables.
 	uint64_t BitPool; ///< Bit pool.
 	int BitsLeft; ///< The number of bits left in the bit pool.
+	bool UseLanes; ///< "True" if the multi-lane generator is in use.
+	uint64_t LaneSeed[ LaneCount ]; ///< Multi-lane PRNG state variables.
+	uint64_t LaneLcg[ LaneCount ]; ///< Multi-lane PRNG state variables.
+	uint64_t LaneHash[ LaneCount ]; ///< Multi-lane PRNG state variables.
+	uint64_t LaneBuf[ LaneBufLen ]; ///< Multi-lane generator's output
+		///< buffer.
+	int LanePos; ///< Read position within the LaneBuf.
+
+	/**
+	 * Function initializes the multi-lane generator's state, using the serial
+	 * generator's output as lane seeds.
+	 */
+
+	void initLanes()
+	{
+		int l;
+
+		for( l = 0; l < LaneCount; l++ )
+		{
+			LaneSeed[ l ] = advance();
+			LaneLcg[ l ] = 0;
+			LaneHash[ l ] = 0;
+		}
+
+		stepLanes( LaneBuf, 5 );
+
+		UseLanes = true;
+		LanePos = LaneBufLen;
+	}
+
+	/**
+	 * Function performs the specified number of steps of all PRNG lanes. The
+	 * lane state is kept in local arrays during the steps, so that the
+	 * compiler can keep it in (SIMD) registers.
+	 *
+	 * @param[out] op Output array, receives StepCount * LaneCount values.
+	 * @param StepCount The number of steps to perform.
+	 */
+
+	void stepLanes( uint64_t* op, const int StepCount )
+	{
+		uint64_t s[ LaneCount ];
+		uint64_t lc[ LaneCount ];
+		uint64_t h[ LaneCount ];
+		int j, l;
+
+		memcpy( s, LaneSeed, sizeof( s ));
+		memcpy( lc, LaneLcg, sizeof( lc ));
+		memcpy( h, LaneHash, sizeof( h ));
+
+		for( j = 0; j < StepCount; j++ )
+		{
+			for( l = 0; l < LaneCount; l++ )
+			{
+				s[ l ] *= lc[ l ] * 2 + 1;
+				const uint64_t rs = s[ l ] >> 32 | s[ l ] << 32;
+				h[ l ] += rs + 0xAAAAAAAAAAAAAAAA;
+				lc[ l ] += s[ l ] + 0x5555555555555555;
+				s[ l ] ^= h[ l ];
+				op[ l ] = lc[ l ] ^ rs;
+			}
+
+			op += LaneCount;
+		}
+
+		memcpy( LaneSeed, s, sizeof( s ));
+		memcpy( LaneLcg, lc, sizeof( lc ));
+		memcpy( LaneHash, h, sizeof( h ));
+	}
+
+	/**
+	 * Function refills the multi-lane generator's output buffer, and resets
+	 * the read position.
+	 */
+
+	void refillLanes()
+	{
+		stepLanes( LaneBuf, LaneBufLen / LaneCount );
+		LanePos = 0;
+	}
 
 	/**
 	 * Function advances the PRNG and returns the next PRNG value.
@@ -362,6 +696,8 @@ protected:
 
 	uint64_t advance()
 	{
+		BITEOPT_STAT( RndDraws, 1 );
+
 		if( rf != NULL )
 		{
 			uint64_t r = ( *rf )( rdata );
@@ -370,6 +706,16 @@ protected:
 			return( r );
 		}
 
+		if( UseLanes )
+		{
+			if( LanePos == LaneBufLen )
+			{
+				refillLanes();
+			}
+
+			return( LaneBuf[ LanePos++ ]);
+		}
+
 		Seed *= lcg * 2 + 1;
 		const uint64_t rs = Seed >> 32 | Seed << 32;
 		Hash += rs + 0xAAAAAAAAAAAAAAAA;
@@ -416,12 +762,14 @@ public:
 		, SelPower( spwr100 * 0.01 )
 		, SelBuf( NULL )
 		, SelBufCapacity( 0 )
+		, SelThr( NULL )
 	{
 	}
 
 	~CBiteSelBase()
 	{
 		delete[] SelBuf;
+		delete[] SelThr;
 	}
 
 	/**
@@ -445,6 +793,12 @@ public:
 			delete[] SelBuf;
 			SelBufCapacity = NewCapacity;
 			SelBuf = new int[ NewCapacity ];
+
+			delete[] SelThr;
+			SelThr = new uint64_t[ CountSp1 ];
+
+			calcPowThr( SlotThr, SlotCount, 1.5 );
+			calcPowThr( SelThr, CountSp, SelPower );
 		}
 
 		int j;
@@ -564,8 +918,13 @@ public:
 
 	int select( CBiteRnd& rnd )
 	{
-		Slot = rnd.getPowInt( 1.5, SlotCount );
-		Selp = rnd.getPowInt( SelPower, CountSp );
+		// Equivalent to rnd.getPowInt( 1.5, SlotCount ) and
+		// rnd.getPowInt( SelPower, CountSp ), via threshold tables.
+
+		Slot = findThr( SlotThr, SlotCount - 1,
+			rnd.getRaw() >> ( 64 - 53 ));
+
+		Selp = findThr( SelThr, CountSp1, rnd.getRaw() >> ( 64 - 53 ));
 
 		Sel = Sels[ Slot ][ Selp ];
 		IsSelected = true;
@@ -619,6 +978,74 @@ protected:
 	int Selp; ///< The index of the choice in the Sels vector.
 	int Slot; ///< The current Sels vector, depending on incr/decr.
 	bool IsSelected; ///< "True" if selection was recently made.
+	uint64_t SlotThr[ SlotCount - 1 ]; ///< Slot selection thresholds, in
+		///< 53-bit random value scale.
+	uint64_t* SelThr; ///< Choice selection thresholds, in 53-bit random
+		///< value scale, length equals CountSp1.
+
+	/**
+	 * Function calculates a threshold table that maps a 53-bit uniform random
+	 * value "u" to the result of the ( (int) ( CBiteRnd::calcPow( u * 2^-53,
+	 * p ) * N1 )) expression, without evaluating a power function. Threshold
+	 * "k" is the least "u" that produces an index above "k". Since the power
+	 * function is monotonic, the table reproduces the expression exactly.
+	 *
+	 * @param[out] Thr Resulting thresholds, N1 - 1 values.
+	 * @param N1 The number of bins.
+	 * @param p Power factor.
+	 */
+
+	static void calcPowThr( uint64_t* const Thr, const int N1, const double p )
+	{
+		int k;
+
+		for( k = 1; k < N1; k++ )
+		{
+			uint64_t lo = 0;
+			uint64_t hi = (uint64_t) 1 << 53;
+
+			while( lo < hi )
+			{
+				const uint64_t mid = ( lo + hi ) >> 1;
+
+				const double v = CBiteRnd :: calcPow( mid * 0x1p-53, p );
+
+				if( (int) ( v * N1 ) >= k )
+				{
+					hi = mid;
+				}
+				else
+				{
+					lo = mid + 1;
+				}
+			}
+
+			Thr[ k - 1 ] = lo;
+		}
+	}
+
+	/**
+	 * Function returns the number of thresholds that are lower or equal to
+	 * the specified value, i.e., the bin index.
+	 *
+	 * @param Thr Thresholds, in ascending order.
+	 * @param n The number of thresholds.
+	 * @param u Value to locate.
+	 */
+
+	static int findThr( const uint64_t* const Thr, const int n,
+		const uint64_t u )
+	{
+		int c = 0;
+		int i;
+
+		for( i = 0; i < n; i++ )
+		{
+			c += ( u >= Thr[ i ]);
+		}
+
+		return( c );
+	}
 };
 
 /**
@@ -664,6 +1091,18 @@ public:
 		, PopParamsBuf( NULL )
 		, PopParams( NULL )
 		, CentParams( NULL )
+		, TierShift( 0 )
+		, TierParams( NULL )
+		, TierStarts( NULL )
+		, TierParamsLen( 0 )
+		, TierStartsLen( 0 )
+		, TierPopSize( DefTierPopSize )
+		, CowBuf( NULL )
+		, CowPtrs( NULL )
+		, CowCount( 0 )
+		, BufParamCount( 0 )
+		, BufPopSize( 0 )
+		, BufReused( false )
 	{
 	}
 
@@ -671,6 +1110,18 @@ public:
 		: PopParamsBuf( NULL )
 		, PopParams( NULL )
 		, CentParams( NULL )
+		, TierShift( 0 )
+		, TierParams( NULL )
+		, TierStarts( NULL )
+		, TierParamsLen( 0 )
+		, TierStartsLen( 0 )
+		, TierPopSize( s.TierPopSize )
+		, CowBuf( NULL )
+		, CowPtrs( NULL )
+		, CowCount( 0 )
+		, BufParamCount( 0 )
+		, BufPopSize( 0 )
+		, BufReused( false )
 	{
 		initBuffers( s.ParamCount, s.PopSize, s.CnsCount, s.ObjCount );
 		copy( s );
@@ -681,6 +1132,9 @@ public:
 		delete[] PopParamsBuf;
 		delete[] PopParams;
 		delete[] CentParams;
+		delete[] TierParams;
+		delete[] TierStarts;
+		delete[] CowPtrs;
 	}
 
 	CBitePop& operator = ( const CBitePop& s )
@@ -696,6 +1150,15 @@ public:
 	 * derived classes' allocated buffers. Allocates an additional vector for
 	 * temporary use, which is at the same the last vector in the PopParams
 	 * array. Derived classes should call this function of the base class.
+	 * Populations with the size of TierPopSize or larger keep the ordering
+	 * in tiers, see getOrderedPtr().
+	 *
+	 * If the parameter count and population size do not exceed those the
+	 * buffers were allocated for, and constraint and objective counts are
+	 * unchanged, the buffers are kept and re-laid out, without calling the
+	 * deleteBuffers() function. BufReused is set to "true" then; derived
+	 * classes should not allocate their buffers in this case, as buffers
+	 * allocated for the larger dimensions fit.
 	 *
 	 * @param aParamCount New parameter count.
 	 * @param aPopSize New population size. If <= 0, population buffers will
@@ -708,7 +1171,17 @@ public:
 	virtual void initBuffers( const int aParamCount, const int aPopSize,
 		const int aCnsCount = 0, const int aObjCount = 1 )
 	{
-		deleteBuffers();
+		BufReused = ( PopParamsBuf != NULL && aParamCount <= BufParamCount &&
+			aPopSize <= BufPopSize && aCnsCount == CnsCount &&
+			aObjCount == ObjCount );
+
+		if( !BufReused )
+		{
+			deleteBuffers();
+
+			BufParamCount = aParamCount;
+			BufPopSize = aPopSize;
+		}
 
 		ParamCount = aParamCount;
 		ParamCountI = 1.0 / ParamCount;
@@ -718,15 +1191,21 @@ public:
 		ObjCount = aObjCount;
 		NeedCentUpdate = false;
 		CentLPC = calcLP1Coeff( PopSize );
+		CowBuf = NULL;
+		CowCount = 0;
 
 		PopCnsOffs = aParamCount * sizeof( ptype );
 		PopObjOffs = PopCnsOffs + aCnsCount * sizeof( double );
 		PopRankOffs = PopObjOffs + aObjCount * sizeof( double );
 		PopItemSize = PopRankOffs + ( aObjCount > 0 ? sizeof( double ) : 0 );
 
-		PopParamsBuf = new uint8_t[( aPopSize + 1 ) * PopItemSize ];
-		PopParams = new ptype*[ aPopSize + 1 ]; // Last element is temporary.
-		CentParams = new ptype[ aParamCount ];
+		if( !BufReused )
+		{
+			PopParamsBuf = new uint8_t[( aPopSize + 1 ) * PopItemSize ];
+			PopParams = new ptype*[ aPopSize + 1 ]; // Last is temporary.
+			CentParams = new ptype[ aParamCount ];
+			CowPtrs = new ptype**[ aPopSize ];
+		}
 
 		int i;
 
@@ -736,6 +1215,44 @@ public:
 		}
 
 		TmpParams = PopParams[ aPopSize ];
+		TierShift = 0;
+
+		if( TierPopSize > 0 && aPopSize >= TierPopSize )
+		{
+			// Tier size is the power of 2, about the square root of the
+			// population size.
+
+			TierShift = 1;
+
+			while(( 1 << ( TierShift * 2 )) < aPopSize )
+			{
+				TierShift++;
+			}
+
+			TierMask = ( 1 << TierShift ) - 1;
+			const int TierCount = ( aPopSize + TierMask ) >> TierShift;
+
+			if(( TierCount << TierShift ) > TierParamsLen )
+			{
+				delete[] TierParams;
+				TierParamsLen = TierCount << TierShift;
+				TierParams = new ptype*[ TierParamsLen ];
+			}
+
+			if( TierCount > TierStartsLen )
+			{
+				delete[] TierStarts;
+				TierStartsLen = TierCount;
+				TierStarts = new int[ TierStartsLen ];
+			}
+
+			memcpy( TierParams, PopParams, aPopSize * sizeof( PopParams[ 0 ]));
+
+			for( i = 0; i < TierCount; i++ )
+			{
+				TierStarts[ i ] = 0;
+			}
+		}
 	}
 
 	/**
@@ -748,57 +1265,145 @@ public:
 
 	void copy( const CBitePop& s )
 	{
-		if( ParamCount != s.ParamCount || PopSize != s.PopSize ||
-			CnsCount != s.CnsCount || ObjCount != s.ObjCount )
-		{
-			initBuffers( s.ParamCount, s.PopSize, s.CnsCount, s.ObjCount );
-		}
-
-		CurPopSize = s.CurPopSize;
-		CurPopSizeI = s.CurPopSizeI;
-		CurPopSize1 = s.CurPopSize1;
-		CurPopPos = s.CurPopPos;
-		NeedCentUpdate = s.NeedCentUpdate;
-		CentLPC = s.CentLPC;
+		copyVars( s );
 
 		int i;
 
 		for( i = 0; i < PopSize; i++ )
 		{
-			memcpy( PopParams[ i ], s.PopParams[ i ], PopItemSize );
-		}
-
-		if( !NeedCentUpdate )
-		{
-			copyParams( CentParams, s.CentParams );
+			memcpy( getParamsOrdered( i ), s.getParamsOrdered( i ),
+				PopItemSize );
 		}
 	}
 
 	/**
-	 * Function recalculates centroid based on the current population size.
-	 * The NeedCentUpdate variable can be checked if centroid update is
-	 * needed. This function resets the NeedCentUpdate to "false". This
-	 * function should only be called after the population is filled.
+	 * Function makes *this population a copy-on-write copy of the specified
+	 * source population: population items are referenced, and not copied.
+	 * An item is copied to *this population's own buffer when it is
+	 * replaced by the updatePop() function of either population. The source
+	 * population should call the unshareItem() function of all its sharers
+	 * before overwriting an item, and these sharers should not outlive
+	 * source population's buffers. Apart from that, this function is
+	 * equivalent to the copy() function.
+	 *
+	 * @param s Source population to share. Should be initalized.
 	 */
 
-	void updateCentroid()
+	void share( const CBitePop& s )
 	{
-		NeedCentUpdate = false;
+		if( s.CowBuf != NULL )
+		{
+			copy( s );
+			return;
+		}
 
-		const int BatchCount = ( 1 << IntOverBits ) - 1;
-		ptype* const cp = CentParams;
-		const double cm = 1.0 / PopSize;
-		ptype* const tp = TmpParams;
-		int i;
-		int j;
+		copyVars( s );
 
-		if( PopSize <= BatchCount )
-		{
-			copyParams( tp, PopParams[ 0 ]);
+		CowBuf = s.PopParamsBuf;
+		CowCount = PopSize;
+
+		int i;
+
+		for( i = 0; i < PopSize; i++ )
+		{
+			*getOrderedPtr( i ) = s.getParamsOrdered( i );
+			trackShared( i );
+		}
+	}
+
+	/**
+	 * Function stops sharing source population's items, and restores own
+	 * item pointers. Population's contents become undefined, and it should
+	 * be refilled, or copied.
+	 */
+
+	void dropShare()
+	{
+		if( CowBuf == NULL )
+		{
+			return;
+		}
+
+		int i;
+
+		for( i = 0; i < PopSize; i++ )
+		{
+			*getOrderedPtr( i ) = (ptype*) ( PopParamsBuf + i * PopItemSize );
+		}
+
+		CowBuf = NULL;
+		CowCount = 0;
+	}
+
+	/**
+	 * Function copies the specified item of the source population to
+	 * *this population's own buffer, if it is shared. Should be called by
+	 * the source population before the item gets overwritten. The item is
+	 * located via the CowPtrs array, in O(1) time.
+	 *
+	 * @param sp Source population's item.
+	 */
+
+	void unshareItem( const ptype* const sp )
+	{
+		const uint8_t* const p = (const uint8_t*) sp;
+
+		if( CowBuf == NULL || p < CowBuf ||
+			p >= CowBuf + PopSize * PopItemSize )
+		{
+			return;
+		}
+
+		ptype** const pp = CowPtrs[( p - CowBuf ) / PopItemSize ];
+
+		if( pp != NULL )
+		{
+			*pp = getOwnItem( *pp );
+		}
+	}
+
+	/**
+	 * Function copies all shared items to *this population's own buffer.
+	 */
+
+	void unshare()
+	{
+		int i;
+
+		for( i = 0; i < PopSize && CowBuf != NULL; i++ )
+		{
+			ptype** const pp = getOrderedPtr( i );
+			*pp = getOwnItem( *pp );
+		}
+	}
+
+	/**
+	 * Function recalculates centroid based on the current population size.
+	 * The NeedCentUpdate variable can be checked if centroid update is
+	 * needed. This function resets the NeedCentUpdate to "false". This
+	 * function should only be called after the population is filled.
+	 */
+
+	void updateCentroid()
+	{
+		BITEOPT_STAT( CentRecomputes, 1 );
+
+		NeedCentUpdate = false;
+
+		const int BatchCount = ( 1 << IntOverBits ) - 1;
+		ptype* const cp = CentParams;
+		const double cm = 1.0 / PopSize;
+		ptype* const tp = TmpParams;
+		int i;
+		int j;
+
+		if( PopSize <= BatchCount )
+		{
+			copyParams( tp, getParamsOrdered( 0 ));
 
 			for( j = 1; j < PopSize; j++ )
 			{
-				const ptype* const p = PopParams[ j ];
+				const ptype* const p = getParamsOrdered( j );
 
 				for( i = 0; i < ParamCount; i++ )
 				{
@@ -826,12 +1431,12 @@ public:
 				pl -= c;
 				c--;
 
-				copyParams( tp, PopParams[ j ]);
+				copyParams( tp, getParamsOrdered( j ));
 
 				while( c > 0 )
 				{
 					j++;
-					const ptype* const p = PopParams[ j ];
+					const ptype* const p = getParamsOrdered( j );
 
 					for( i = 0; i < ParamCount; i++ )
 					{
@@ -881,7 +1486,30 @@ public:
 
 	ptype* getParamsOrdered( const int i ) const
 	{
-		return( PopParams[ i ]);
+		return( *getOrderedPtr( i ));
+	}
+
+	/**
+	 * Function returns a pointer to the element of the ordered list of
+	 * population vectors. Small populations keep the ordered list in the
+	 * PopParams array. Large populations keep it in tiers: ring buffers of
+	 * equal size, which reduces the cost of updatePop() from O(PopSize) to
+	 * O(sqrt(PopSize)), with an O(1) access.
+	 *
+	 * @param i Parameter vector index.
+	 */
+
+	ptype** getOrderedPtr( const int i ) const
+	{
+		if( TierShift == 0 )
+		{
+			return( PopParams + i );
+		}
+
+		const int t = i >> TierShift;
+
+		return( TierParams + ( t << TierShift ) +
+			(( TierStarts[ t ] + i ) & TierMask ));
 	}
 
 	/**
@@ -922,14 +1550,54 @@ public:
 
 	/**
 	 * Function returns a pointer to array of population vector pointers,
-	 * which are sorted in the ascending cost order.
+	 * which are sorted in the ascending cost order. If population is kept in
+	 * tiers, the array is a snapshot, and the commitPopParams() function
+	 * should be called after the array was reordered.
 	 */
 
 	ptype** getPopParams() const
 	{
+		if( TierShift != 0 )
+		{
+			int i;
+
+			for( i = 0; i < PopSize; i++ )
+			{
+				PopParams[ i ] = getParamsOrdered( i );
+			}
+		}
+
 		return( PopParams );
 	}
 
+	/**
+	 * Function applies the order of the array returned by the
+	 * getPopParams() function.
+	 */
+
+	void commitPopParams()
+	{
+		if( TierShift != 0 )
+		{
+			int i;
+
+			for( i = 0; i < PopSize; i++ )
+			{
+				*getOrderedPtr( i ) = PopParams[ i ];
+			}
+		}
+
+		if( CowBuf != NULL )
+		{
+			int i;
+
+			for( i = 0; i < PopSize; i++ )
+			{
+				trackShared( i );
+			}
+		}
+	}
+
 	/**
 	 * Function returns pointer to the next available parameter vector, at the
 	 * initialization stage. When the population was filled, the function
@@ -938,7 +1606,18 @@ public:
 
 	ptype* getCurParams() const
 	{
-		return( PopParams[ CurPopPos ]);
+		return( CurPopPos < PopSize ? getParamsOrdered( CurPopPos ) :
+			TmpParams );
+	}
+
+	/**
+	 * Function returns population size, the maximal current population
+	 * size.
+	 */
+
+	int getPopSize() const
+	{
+		return( PopSize );
 	}
 
 	/**
@@ -959,6 +1638,57 @@ public:
 		return( CurPopPos );
 	}
 
+	/**
+	 * Function returns the relative rank spread of the current population:
+	 * the difference between the worst and the best ranks, relative to
+	 * their mean magnitude. Ranks within 1e-10 of zero are considered equal
+	 * to zero. Population should be filled.
+	 */
+
+	double calcRankSpread() const
+	{
+		const double r0 = *getRankPtr( getParamsOrdered( 0 ));
+		const double r1 = *getRankPtr( getParamsOrdered( CurPopSize1 ));
+
+		return( 2.0 * ( r1 - r0 ) / ( fabs( r0 ) + fabs( r1 ) + 1e-10 ));
+	}
+
+	/**
+	 * Function returns the parameter spread of the current population: the
+	 * maximal distance between a parameter value and its centroid value,
+	 * relative to the parameter's range. The centroid should be up to date.
+	 * Population should be filled.
+	 */
+
+	double calcParamSpread() const
+	{
+		ptype md = 0;
+		int i;
+		int j;
+
+		for( j = 0; j < CurPopSize; j++ )
+		{
+			const ptype* const p = getParamsOrdered( j );
+
+			for( i = 0; i < ParamCount; i++ )
+			{
+				const ptype d = p[ i ] - CentParams[ i ];
+
+				if( d > md )
+				{
+					md = d;
+				}
+				else
+				if( -d > md )
+				{
+					md = -d;
+				}
+			}
+		}
+
+		return( (ptype) 0.25 == 0 ? md * MantMultI : (double) md );
+	}
+
 	/**
 	 * Function resets the current population position to zero, and sets
 	 * CurPopSize to PopSize. This function is usually called when the
@@ -969,6 +1699,8 @@ public:
 
 	void resetCurPopPos()
 	{
+		dropShare();
+
 		CurPopSize = PopSize;
 		CurPopSizeI = 1.0 / PopSize;
 		CurPopSize1 = PopSize1;
@@ -1028,10 +1760,12 @@ public:
 
 		if( p < ri )
 		{
-			ptype** const pp = PopParams + p;
-			ptype* const rp = *pp;
-			memmove( pp, pp + 1, ( ri - p ) * sizeof( pp[ 0 ]));
-			PopParams[ ri ] = rp;
+			removeOrdered( p, ri );
+
+			if( CowBuf != NULL )
+			{
+				trackShared( p, ri );
+			}
 		}
 
 		CurPopPos--;
@@ -1054,13 +1788,20 @@ public:
 	 * replace an existing solution in the population. Such replacing reduces
 	 * diversity of competing same-cost best solutions, and usually improves
 	 * convergence.
+	 * @param UpdCns Constraint values of the new solution, CnsCount elements,
+	 * can be NULL if not available.
+	 * @param UpdObjs Objective values of the new solution, ObjCount
+	 * elements. If NULL, the first objective value is set to UpdCost.
 	 * @return Insertion position - greater or equal to PopSize, if the cost
 	 * constraint was not met.
 	 */
 
 	int updatePop( double UpdCost, const ptype* const UpdParams,
-		const bool DoUpdateCentroid = false, const int ReplaceThrN8 = 0 )
+		const bool DoUpdateCentroid = false, const int ReplaceThrN8 = 0,
+		const double* const UpdCns = NULL, const double* const UpdObjs = NULL )
 	{
+		BITEOPT_STAT( UpdatePopCalls, 1 );
+
 		int ri; // Index of population vector to be replaced.
 
 		if( CurPopPos < PopSize )
@@ -1071,8 +1812,9 @@ public:
 		{
 			ri = PopSize1;
 
-			if( UpdCost > *getRankPtr( PopParams[ ri ]))
+			if( UpdCost > *getRankPtr( getParamsOrdered( ri )))
 			{
+				BITEOPT_STAT( UpdatePopRejects, 1 );
 				return( PopSize );
 			}
 		}
@@ -1086,7 +1828,7 @@ public:
 		{
 			const int mid = ( p + i ) >> 1;
 
-			if( *getRankPtr( PopParams[ mid ]) >= UpdCost )
+			if( *getRankPtr( getParamsOrdered( mid )) >= UpdCost )
 			{
 				i = mid;
 			}
@@ -1105,13 +1847,13 @@ public:
 		}
 		else
 		{
-			if( isEqual( UpdCost, *getRankPtr( PopParams[ p ])))
+			if( isEqual( UpdCost, *getRankPtr( getParamsOrdered( p ))))
 			{
 				IsEqualCost = true;
 
 				if( p != 0 && p < CurPopSize * ReplaceThrN8 / 8 &&
-					isParams1FartherThan2( PopParams[ p ], UpdParams,
-					PopParams[ 0 ]))
+					isParams1FartherThan2( getParamsOrdered( p ), UpdParams,
+					getParamsOrdered( 0 )))
 				{
 					DoReplace = true;
 				}
@@ -1122,22 +1864,43 @@ public:
 
 		if( DoReplace )
 		{
-			rp = PopParams[ p ];
+			BITEOPT_STAT( UpdatePopReplaces, 1 );
+
+			ptype** const pp = getOrderedPtr( p );
+			rp = getOwnItem( *pp );
+			*pp = rp;
 		}
 		else
 		{
-			rp = PopParams[ ri ];
+			BITEOPT_STAT( MoveDist, ri - p );
 
-			const int mc = ri - p;
-			ptype** const pp = PopParams + p;
-			memmove( pp + 1, pp, mc * sizeof( pp[ 0 ]));
+			rp = getOwnItem( getParamsOrdered( ri ));
+			insertOrdered( p, ri, rp );
 
-			*pp = rp;
+			if( CowBuf != NULL )
+			{
+				trackShared( p, ri );
+			}
+		}
+
+		beforeItemWrite( rp );
+
+		if( UpdObjs != NULL )
+		{
+			memcpy( getObjPtr( rp ), UpdObjs, ObjCount * sizeof( UpdObjs[ 0 ]));
+		}
+		else
+		{
+			*getObjPtr( rp ) = UpdCost;
 		}
 
-		*getObjPtr( rp ) = UpdCost;
 		*getRankPtr( rp ) = UpdCost;
 
+		if( UpdCns != NULL )
+		{
+			memcpy( getCnsPtr( rp ), UpdCns, CnsCount * sizeof( UpdCns[ 0 ]));
+		}
+
 		if( rp != UpdParams )
 		{
 			if( DoUpdateCentroid && !NeedCentUpdate )
@@ -1225,96 +1988,411 @@ protected:
 	double CentLPC; ///< Centroid averaging filter coefficient.
 	ptype* TmpParams; ///< Temporary parameter vector, points to the last
 		///< element of the PopParams array.
+	static const int DefTierPopSize = 2048; ///< Default TierPopSize.
+	int TierShift; ///< Tier size, log2. If equals 0, tiers are not used, and
+		///< the ordered list is kept in the PopParams array.
+	int TierMask; ///< Tier size minus 1.
+	ptype** TierParams; ///< Tiers of the ordered list of population vectors,
+		///< each tier is a ring buffer, see getOrderedPtr().
+	int* TierStarts; ///< Ring buffer start offsets of tiers.
+	int TierParamsLen; ///< Allocated length of the TierParams array.
+	int TierStartsLen; ///< Allocated length of the TierStarts array.
+	int TierPopSize; ///< Minimal population size that uses tiers, 0 -
+		///< tiers are not used. Should be changed before the initBuffers()
+		///< function call.
+	const uint8_t* CowBuf; ///< PopParamsBuf of the source population whose
+		///< items are shared, NULL if no items are shared, see share().
+	ptype*** CowPtrs; ///< Ordered list elements that hold shared items,
+		///< indexed by item's position in source's buffer; NULL if the item
+		///< is no longer shared. Valid while CowBuf is not NULL.
+	int CowCount; ///< The number of items that are still shared.
+	int BufParamCount; ///< Parameter count the buffers were allocated for.
+	int BufPopSize; ///< Population size the buffers were allocated for.
+	bool BufReused; ///< "True" if the latest initBuffers() call kept the
+		///< previously allocated buffers.
 
 	/**
-	 * Function deletes buffers previously allocated via the initBuffers()
-	 * function. Derived classes should call this function of the base class.
+	 * Function copies population's variables and the centroid from the
+	 * specified source population, and initializes buffers if *this
+	 * population has a different size. Used by the copy() and share()
+	 * functions.
+	 *
+	 * @param s Source population. Should be initalized.
 	 */
 
-	virtual void deleteBuffers()
+	void copyVars( const CBitePop& s )
 	{
-		delete[] PopParamsBuf;
-		delete[] PopParams;
-		delete[] CentParams;
-	}
+		if( ParamCount != s.ParamCount || PopSize != s.PopSize ||
+			CnsCount != s.CnsCount || ObjCount != s.ObjCount )
+		{
+			initBuffers( s.ParamCount, s.PopSize, s.CnsCount, s.ObjCount );
+		}
+		else
+		{
+			dropShare();
+		}
 
-	/**
-	 * An aux function that resets a parameter vector to zero values.
-	 *
-	 * @param[out] dst Destination vector.
-	 */
+		CurPopSize = s.CurPopSize;
+		CurPopSizeI = s.CurPopSizeI;
+		CurPopSize1 = s.CurPopSize1;
+		CurPopPos = s.CurPopPos;
+		NeedCentUpdate = s.NeedCentUpdate;
+		CentLPC = s.CentLPC;
 
-	void zeroParams( ptype* const dst ) const
-	{
-		memset( dst, 0, ParamCount * sizeof( dst[ 0 ]));
+		if( !NeedCentUpdate )
+		{
+			copyParams( CentParams, s.CentParams );
+		}
 	}
 
 	/**
-	 * An aux function that copies a parameter vector.
+	 * Function returns a pointer to the own copy of the specified item, if
+	 * the item is shared with the source population, see share(). The
+	 * returned pointer should replace the item's pointer in the PopParams
+	 * array. An own copy occupies the same buffer position as the source
+	 * item does in source's buffer.
 	 *
-	 * @param[out] dst Destination vector.
-	 * @param[in] src Source vector.
+	 * @param pp Population item.
 	 */
 
-	void copyParams( ptype* const dst, const ptype* const src ) const
+	ptype* getOwnItem( ptype* const pp )
 	{
-		memcpy( dst, src, ParamCount * sizeof( dst[ 0 ]));
+		const uint8_t* const p = (const uint8_t*) pp;
+
+		if( CowBuf == NULL || p < CowBuf ||
+			p >= CowBuf + PopSize * PopItemSize )
+		{
+			return( pp );
+		}
+
+		ptype* const op = (ptype*) ( PopParamsBuf + ( p - CowBuf ));
+		memcpy( op, pp, PopItemSize );
+
+		CowPtrs[( p - CowBuf ) / PopItemSize ] = NULL;
+		CowCount--;
+
+		if( CowCount == 0 )
+		{
+			CowBuf = NULL;
+		}
+
+		return( op );
 	}
 
 	/**
-	 * An aux function that copies a real solution vector.
+	 * Function records the position of the specified element of the ordered
+	 * list in the CowPtrs array, if the element holds a shared item.
 	 *
-	 * @param[out] dst Destination vector.
-	 * @param[in] src Source vector.
+	 * @param i Ordered list's element index.
 	 */
 
-	void copyValues( double* const dst, const double* const src ) const
+	void trackShared( const int i )
 	{
-		memcpy( dst, src, ParamCount * sizeof( dst[ 0 ]));
+		ptype** const pp = getOrderedPtr( i );
+		const uint8_t* const p = (const uint8_t*) *pp;
+
+		if( p >= CowBuf && p < CowBuf + PopSize * PopItemSize )
+		{
+			CowPtrs[( p - CowBuf ) / PopItemSize ] = pp;
+		}
 	}
 
 	/**
-	 * Function compares two floating-point values for equality.
+	 * Function updates the CowPtrs array after the insertOrdered() or
+	 * removeOrdered() function call with the same range. With tiers, only
+	 * the elements these functions write to are considered: the ends of the
+	 * range, and the first and last elements of tiers in-between, which
+	 * keeps the cost at O(sqrt(PopSize)).
 	 *
-	 * @param a Value 1.
-	 * @param b Value 2.
-	 * @param etol Value equality tolerance.
-	 * @return "True" if values are equal.
+	 * @param p Start of the range.
+	 * @param ri End of the range, inclusive.
 	 */
 
-	static bool isEqual( const double a, const double b,
-		const double etol = 0x1p-52 )
+	void trackShared( const int p, const int ri )
 	{
-		const double d = fabs( b - a );
+		int i;
 
-		if( d == 0.0 )
+		if( TierShift == 0 || ( p >> TierShift ) == ( ri >> TierShift ))
 		{
-			return( true );
+			for( i = p; i <= ri; i++ )
+			{
+				trackShared( i );
+			}
+
+			return;
 		}
 
-		const double s = fabs( b ) + fabs( a );
+		const int tr = ri >> TierShift;
+		int t = p >> TierShift;
 
-		if( d < s * etol )
+		for( i = p; i <= ( t << TierShift ) + TierMask; i++ )
 		{
-			return( true );
+			trackShared( i );
 		}
 
-		return( false );
+		for( t++; t < tr; t++ )
+		{
+			trackShared( t << TierShift );
+			trackShared(( t << TierShift ) + TierMask );
+		}
+
+		for( i = tr << TierShift; i <= ri; i++ )
+		{
+			trackShared( i );
+		}
 	}
 
 	/**
-	 * Function compares distances of parameter vectors 1 and 2 to a reference
-	 * vector, and returns "true" if distance 1 is greater than 2.
+	 * Function is called by the updatePop() function before the specified
+	 * item gets overwritten. Populations that are shared via the share()
+	 * function should call sharers' unshareItem() function here.
 	 *
-	 * @param p1 Parameter vector 1.
-	 * @param p2 Parameter vector 2.
-	 * @param RefParams Reference parameter vector.
+	 * @param pp Population item that is about to be overwritten.
 	 */
 
-	bool isParams1FartherThan2( const ptype* const p1, const ptype* const p2,
-		const ptype* const RefParams ) const
+	virtual void beforeItemWrite( const ptype* const pp )
 	{
-		double s0 = 0.0;
+	}
+
+	/**
+	 * Function inserts a vector into the ordered list, shifting the elements
+	 * in the [p; ri) range by one position, and overwriting the element at
+	 * the "ri" position.
+	 *
+	 * @param p Insertion position.
+	 * @param ri Position of the replaced element, >= p.
+	 * @param rp Vector to insert.
+	 */
+
+	void insertOrdered( const int p, const int ri, ptype* const rp )
+	{
+		if( TierShift == 0 )
+		{
+			ptype** const pp = PopParams + p;
+			memmove( pp + 1, pp, ( ri - p ) * sizeof( pp[ 0 ]));
+
+			*pp = rp;
+			return;
+		}
+
+		// An element shifted out of a tier is carried over to the start of
+		// the next tier, which is a ring buffer rotation for fully-shifted
+		// tiers in-between.
+
+		const int tr = ri >> TierShift;
+		int t = p >> TierShift;
+		int o = p & TierMask;
+		ptype* c = rp;
+		int j;
+
+		while( t < tr )
+		{
+			ptype** const tp = TierParams + ( t << TierShift );
+			const int s = TierStarts[ t ];
+			const int ls = ( s + TierMask ) & TierMask;
+			ptype* const l = tp[ ls ];
+
+			if( o == 0 )
+			{
+				tp[ ls ] = c;
+				TierStarts[ t ] = ls;
+			}
+			else
+			{
+				for( j = TierMask; j > o; j-- )
+				{
+					tp[( s + j ) & TierMask ] = tp[( s + j - 1 ) & TierMask ];
+				}
+
+				tp[( s + o ) & TierMask ] = c;
+			}
+
+			c = l;
+			o = 0;
+			t++;
+		}
+
+		ptype** const tp = TierParams + ( tr << TierShift );
+		const int s = TierStarts[ tr ];
+
+		for( j = ri & TierMask; j > o; j-- )
+		{
+			tp[( s + j ) & TierMask ] = tp[( s + j - 1 ) & TierMask ];
+		}
+
+		tp[( s + o ) & TierMask ] = c;
+	}
+
+	/**
+	 * Function removes an element from the ordered list of population
+	 * vectors, by shifting elements down to the "ri" position, and places the
+	 * removed element at the "ri" position.
+	 *
+	 * @param p Position of the removed element.
+	 * @param ri Position to place the removed element at, >= p.
+	 */
+
+	void removeOrdered( const int p, const int ri )
+	{
+		if( TierShift == 0 )
+		{
+			ptype** const pp = PopParams + p;
+			ptype* const rp = *pp;
+			memmove( pp, pp + 1, ( ri - p ) * sizeof( pp[ 0 ]));
+
+			PopParams[ ri ] = rp;
+			return;
+		}
+
+		// The end of a tier is filled with the start element of the next
+		// tier, which is a ring buffer rotation for fully-shifted tiers
+		// in-between.
+
+		const int tr = ri >> TierShift;
+		int t = p >> TierShift;
+		int o = p & TierMask;
+		ptype** tp = TierParams + ( t << TierShift );
+		int s = TierStarts[ t ];
+		ptype* const rp = tp[( s + o ) & TierMask ];
+		int j;
+
+		while( t < tr )
+		{
+			for( j = o; j < TierMask; j++ )
+			{
+				tp[( s + j ) & TierMask ] = tp[( s + j + 1 ) & TierMask ];
+			}
+
+			ptype** const ep = tp + (( s + TierMask ) & TierMask );
+
+			t++;
+			tp = TierParams + ( t << TierShift );
+			s = TierStarts[ t ];
+			*ep = tp[ s ];
+
+			if( t < tr )
+			{
+				s = ( s + 1 ) & TierMask;
+				TierStarts[ t ] = s;
+				o = TierMask;
+			}
+			else
+			{
+				o = 0;
+			}
+		}
+
+		const int e = ri & TierMask;
+
+		for( j = o; j < e; j++ )
+		{
+			tp[( s + j ) & TierMask ] = tp[( s + j + 1 ) & TierMask ];
+		}
+
+		tp[( s + e ) & TierMask ] = rp;
+	}
+
+	/**
+	 * Function deletes buffers previously allocated via the initBuffers()
+	 * function. Derived classes should call this function of the base class.
+	 */
+
+	virtual void deleteBuffers()
+	{
+		delete[] PopParamsBuf;
+		delete[] PopParams;
+		delete[] CentParams;
+		delete[] TierParams;
+		delete[] TierStarts;
+		delete[] CowPtrs;
+
+		PopParamsBuf = NULL;
+		PopParams = NULL;
+		CentParams = NULL;
+		TierParams = NULL;
+		TierStarts = NULL;
+		CowPtrs = NULL;
+		TierParamsLen = 0;
+		TierStartsLen = 0;
+	}
+
+	/**
+	 * An aux function that resets a parameter vector to zero values.
+	 *
+	 * @param[out] dst Destination vector.
+	 */
+
+	void zeroParams( ptype* const dst ) const
+	{
+		memset( dst, 0, ParamCount * sizeof( dst[ 0 ]));
+	}
+
+	/**
+	 * An aux function that copies a parameter vector.
+	 *
+	 * @param[out] dst Destination vector.
+	 * @param[in] src Source vector.
+	 */
+
+	void copyParams( ptype* const dst, const ptype* const src ) const
+	{
+		memcpy( dst, src, ParamCount * sizeof( dst[ 0 ]));
+	}
+
+	/**
+	 * An aux function that copies a real solution vector.
+	 *
+	 * @param[out] dst Destination vector.
+	 * @param[in] src Source vector.
+	 */
+
+	void copyValues( double* const dst, const double* const src ) const
+	{
+		memcpy( dst, src, ParamCount * sizeof( dst[ 0 ]));
+	}
+
+	/**
+	 * Function compares two floating-point values for equality.
+	 *
+	 * @param a Value 1.
+	 * @param b Value 2.
+	 * @param etol Value equality tolerance.
+	 * @return "True" if values are equal.
+	 */
+
+	static bool isEqual( const double a, const double b,
+		const double etol = 0x1p-52 )
+	{
+		const double d = fabs( b - a );
+
+		if( d == 0.0 )
+		{
+			return( true );
+		}
+
+		const double s = fabs( b ) + fabs( a );
+
+		if( d < s * etol )
+		{
+			return( true );
+		}
+
+		return( false );
+	}
+
+	/**
+	 * Function compares distances of parameter vectors 1 and 2 to a reference
+	 * vector, and returns "true" if distance 1 is greater than 2.
+	 *
+	 * @param p1 Parameter vector 1.
+	 * @param p2 Parameter vector 2.
+	 * @param RefParams Reference parameter vector.
+	 */
+
+	bool isParams1FartherThan2( const ptype* const p1, const ptype* const p2,
+		const ptype* const RefParams ) const
+	{
+		double s0 = 0.0;
 		double s1 = 0.0;
 		int i;
 
@@ -1347,6 +2425,8 @@ protected:
 		{
 			if( v < 0 )
 			{
+				BITEOPT_STAT( WrapHits, 1 );
+
 				if( v > IntMantMultM )
 				{
 					return( (ptype) ( rnd.get() * -v ));
@@ -1357,6 +2437,8 @@ protected:
 
 			if( v > IntMantMult )
 			{
+				BITEOPT_STAT( WrapHits, 1 );
+
 				if( v < IntMantMult2 )
 				{
 					return( (ptype) ( IntMantMult -
@@ -1372,6 +2454,8 @@ protected:
 		{
 			if( v < 0.0 )
 			{
+				BITEOPT_STAT( WrapHits, 1 );
+
 				if( v > -1.0 )
 				{
 					return( (ptype) ( rnd.get() * -v ));
@@ -1382,6 +2466,8 @@ protected:
 
 			if( v > 1.0 )
 			{
+				BITEOPT_STAT( WrapHits, 1 );
+
 				if( v < 2.0 )
 				{
 					return( (ptype) ( 1.0 - rnd.get() * ( v - 1.0 )));
@@ -1474,6 +2560,64 @@ protected:
 		///< be changed via the setParPopCount() function.
 	double* ParValues; ///< Temporary value buffer, length equals ParPopCount.
 
+	virtual void beforeItemWrite( const ptype* const pp )
+	{
+		int i;
+
+		for( i = 0; i < ParPopCount; i++ )
+		{
+			ParPops[ i ] -> unshareItem( pp );
+		}
+	}
+
+	/**
+	 * Function makes all parallel populations copy-on-write copies of
+	 * `this` population, see CBitePop::share().
+	 */
+
+	void shareParPops()
+	{
+		int i;
+
+		for( i = 0; i < ParPopCount; i++ )
+		{
+			ParPops[ i ] -> share( *this );
+		}
+	}
+
+	/**
+	 * Function copies all items still shared with `this` population to
+	 * parallel populations' own buffers. Should be called before `this`
+	 * population's items are changed in place, outside the updatePop()
+	 * function.
+	 */
+
+	void unshareParPops()
+	{
+		int i;
+
+		for( i = 0; i < ParPopCount; i++ )
+		{
+			ParPops[ i ] -> unshare();
+		}
+	}
+
+	/**
+	 * Function stops item sharing by parallel populations, whose contents
+	 * become undefined. Should be called when `this` population is
+	 * reinitialized.
+	 */
+
+	void dropParPopsShare()
+	{
+		int i;
+
+		for( i = 0; i < ParPopCount; i++ )
+		{
+			ParPops[ i ] -> dropShare();
+		}
+	}
+
 	/**
 	 * Function changes the parallel population count, and reallocates
 	 * buffers.
@@ -1524,6 +2668,8 @@ protected:
 
 	void calcCentroidDists( const ptype* const Params, double* s ) const
 	{
+		BITEOPT_STAT( CentDistCalls, 1 );
+
 		int k = 0;
 		int i;
 
@@ -1671,6 +2817,17 @@ protected:
 class CBiteOptInterface
 {
 public:
+	/**
+	 * Parameter types, see CBiteOptBase::setParamTypes().
+	 */
+
+	enum EParamType
+	{
+		ptContinuous, // Continuous parameter.
+		ptInteger, // Integer parameter.
+		ptCategorical // Categorical parameter, holds a category index.
+	};
+
 	CBiteOptInterface()
 	{
 	}
@@ -1732,6 +2889,108 @@ public:
 	 */
 
 	virtual double optcost( const double* const p ) = 0;
+
+	/**
+	 * Virtual function that should calculate objective values of the
+	 * parameter vector, for multi-objective optimization. This function is
+	 * called only by optimizers that were set up with several objectives,
+	 * instead of the optcost() function. The default implementation calls
+	 * the optcost() function.
+	 *
+	 * @param p Parameter vector to evaluate.
+	 * @param[out] objs Objective values.
+	 */
+
+	virtual void optobjs( const double* const p, double* const objs )
+	{
+		objs[ 0 ] = optcost( p );
+	}
+
+	/**
+	 * Virtual function that should calculate constraint values of the
+	 * parameter vector. A constraint is satisfied, if its value is less or
+	 * equal to 0. This function is called only by optimizers that were set
+	 * up with a non-zero constraint count, before calling the optcost()
+	 * function, which is not called if any constraint is not satisfied.
+	 *
+	 * @param p Parameter vector to evaluate.
+	 * @param[out] c Constraint values.
+	 */
+
+	virtual void optcns( const double* const p, double* const c )
+	{
+	}
+
+	/**
+	 * Function evaluates the rank of the parameter vector: calls the
+	 * optcost() function by default. Optimizers that use constraints
+	 * evaluate constraints first, and return a constraint violation-based
+	 * rank for infeasible vectors, without calling the optcost() function,
+	 * see CBiteOptBase::calcCnsRank(). Parallel optimizers that are owned by
+	 * an optimizer call the owner's optrank() function.
+	 *
+	 * @param p Parameter vector to evaluate.
+	 * @return Rank of the parameter vector.
+	 */
+
+	virtual double optrank( const double* const p )
+	{
+		return( optcost( p ));
+	}
+
+	/**
+	 * Function returns the cost upper bound of the solution being currently
+	 * evaluated, for use within the optcost() function. A solution with a
+	 * cost above this bound will be rejected by the optimizer, so the
+	 * objective function may stop its calculation as soon as it knows the
+	 * cost exceeds the bound, and return any value above the bound.
+	 *
+	 * @return Cost upper bound, 1e300 if there is no bound.
+	 */
+
+	virtual double getCostBound() const
+	{
+		return( 1e300 );
+	}
+
+	/**
+	 * Function returns "true" if the optcost() function may stop at the
+	 * getCostBound() value, and return a partial cost above it. Evaluation
+	 * caches of optimizers store costs above the bound only if this function
+	 * returns "false". Optimizers that are owned by an optimizer return the
+	 * owner's value.
+	 */
+
+	virtual bool isCostBoundUsed() const
+	{
+		return( true );
+	}
+
+	/**
+	 * Function provides information about the parent of the solution being
+	 * currently evaluated, for use within the optcost() function. Some
+	 * solution generators produce a solution by changing a few parameters of
+	 * an already evaluated solution; an objective function that is a sum of
+	 * per-parameter terms can then be updated from the parent's cost, in
+	 * O(changed) time.
+	 *
+	 * @param[out] ParentValues Parent's parameter values, ParamCount
+	 * elements. Note that these values may differ from the values the parent
+	 * was evaluated with by a rounding error.
+	 * @param[out] ParentCost Parent's cost.
+	 * @param[out] Changed Indices of parameters that differ from the parent's,
+	 * in ascending order, up to ParamCount elements.
+	 * @return The number of parameters that differ from the parent's, -1 if
+	 * the solution has no single parent, or if the parent's cost is not an
+	 * objective function value (an infeasible solution's rank, or a cost of
+	 * 1e200 and above), and the outputs were not filled.
+	 */
+
+	virtual int getDeltaParent( double* const ParentValues,
+		double* const ParentCost, int* const Changed ) const
+	{
+		return( -1 );
+	}
 };
 
 /**
@@ -1767,7 +3026,13 @@ public:
 		, DiffValuesI( NULL )
 		, StartParams( NULL )
 		, BestValues( NULL )
+		, NewCosts( NULL )
 		, NewValues( NULL )
+		, NewCns( NULL )
+		, ParamTypes( NULL )
+		, DiscMin( NULL )
+		, DiscCount( NULL )
+		, DiscCountI( NULL )
 		, SelCount( 0 )
 	{
 	}
@@ -1780,7 +3045,12 @@ public:
 		delete[] DiffValuesI;
 		delete[] StartParams;
 		delete[] BestValues;
+		delete[] NewCosts;
 		delete[] NewValues;
+		delete[] NewCns;
+		delete[] DiscMin;
+		delete[] DiscCount;
+		delete[] DiscCountI;
 	}
 
 	virtual const double* getBestParams() const
@@ -1830,20 +3100,95 @@ public:
 		return( SelCount );
 	}
 
+	/**
+	 * Function assigns parameter types. Integer and categorical parameters
+	 * take integer values within [ceil(MinValue); floor(MaxValue)] range:
+	 * the normalized range is divided into equal bins, one per value, and
+	 * real values are snapped to bins in the getRealValue() function.
+	 * Categorical parameters differ only in their meaning: their values are
+	 * category indices, with no order implied. The range of such parameter
+	 * should include at least one integer value. Should be called before
+	 * the init() function.
+	 *
+	 * @param aParamTypes Parameter types, ParamCount elements, see
+	 * EParamType. NULL if all parameters are continuous. The array should
+	 * stay valid while *this object is in use.
+	 */
+
+	virtual void setParamTypes( const int* const aParamTypes )
+	{
+		ParamTypes = aParamTypes;
+	}
+
 	/**
 	 * Returns the number of iterations without improvement.
 	 */
 
-	int getStallCount() const
+	int64_t getStallCount() const
 	{
 		return( StallCount );
 	}
 
+	virtual double optrank( const double* const p )
+	{
+		if( CnsCount == 0 )
+		{
+			return( optcost( p ));
+		}
+
+		optcns( p, NewCns );
+
+		const double r = calcCnsRank( NewCns, CnsCount );
+
+		return( r > 0.0 ? r : optcost( p ));
+	}
+
+	/**
+	 * Function calculates the rank of an infeasible solution using the
+	 * feasibility rules: any infeasible solution ranks worse than any
+	 * feasible solution with cost below 1e200, infeasible solutions are
+	 * ranked by the sum of constraint violations. NaN constraint values
+	 * are considered violated by 1.
+	 *
+	 * @param c Constraint values.
+	 * @param Count The number of constraint values.
+	 * @return Infeasible solution's rank, 0 if the solution is feasible.
+	 */
+
+	static double calcCnsRank( const double* const c, const int Count )
+	{
+		double v = 0.0;
+		int i;
+
+		for( i = 0; i < Count; i++ )
+		{
+			if( c[ i ] > 0.0 )
+			{
+				v += c[ i ];
+			}
+			else
+			if( c[ i ] != c[ i ])
+			{
+				v += 1.0;
+			}
+		}
+
+		if( v == 0.0 )
+		{
+			return( 0.0 );
+		}
+
+		return( v < 1e98 ? 1e200 * ( 1.0 + v ) : 1e298 );
+	}
+
 protected:
 	using CBiteParPops< ptype > :: IntMantMult;
 	using CBiteParPops< ptype > :: MantMult;
 	using CBiteParPops< ptype > :: MantMultI;
 	using CBiteParPops< ptype > :: ParamCount;
+	using CBiteParPops< ptype > :: CnsCount;
+	using CBiteParPops< ptype > :: ObjCount;
+	using CBiteParPops< ptype > :: BufReused;
 	using CBiteParPops< ptype > :: CurPopPos;
 	using CBiteParPops< ptype > :: resetCurPopPos;
 	using CBiteParPops< ptype > :: copyValues;
@@ -1860,17 +3205,25 @@ protected:
 	double StartSD; ///< Starting standard deviation.
 	double* BestValues; ///< Best parameter vector.
 	double BestCost; ///< Cost of the best parameter vector.
-	double NewCosts[ 1 ]; ///< Temporary buffer to contain objective function
-		///< value(s). Pointer to this buffer is retained in init() call.
+	double* NewCosts; ///< Temporary buffer to contain objective function
+		///< value(s), ObjCount elements. Pointer to this buffer is retained
+		///< in init() call.
 	double* NewValues; ///< New parameter values buffer, with real values,
 		///< can be also used as a temporary buffer. Pointer to this buffer
 		///< is retained in init() call.
+	double* NewCns; ///< Constraint values of the latest optrank() call,
+		///< NULL if CnsCount equals 0.
+	const int* ParamTypes; ///< Parameter types, NULL if all parameters are
+		///< continuous.
+	double* DiscMin; ///< Minimal value of discrete parameters.
+	double* DiscCount; ///< The number of values of discrete parameters.
+	double* DiscCountI; ///< Inverse DiscCount.
 	const double* LastCosts; ///< Cost(s) of the latest optcost() call. Points
 		///< to NewCosts by default.
 	const double* LastValues; ///< Parameter values of the latest optcost()
 		///< call. Points to NewValues by default.
 	bool DoInitEvals; ///< "True" if initial evaluations should be performed.
-	int StallCount; ///< The number of iterations without improvement.
+	int64_t StallCount; ///< The number of iterations without improvement.
 	double HiBound; ///< Higher cost bound, for StallCount estimation. May not
 		///< be used by the optimizer.
 	double AvgCost; ///< Average cost in the latest batch. May not be used by
@@ -1892,13 +3245,23 @@ protected:
 		CBiteParPops< ptype > :: initBuffers( aParamCount, aPopSize,
 			aCnsCount, aObjCount );
 
+		if( BufReused )
+		{
+			return;
+		}
+
 		MinValues = new double[ ParamCount ];
 		MaxValues = new double[ ParamCount ];
 		DiffValues = new double[ ParamCount ];
 		DiffValuesI = new double[ ParamCount ];
 		StartParams = new ptype[ ParamCount ];
 		BestValues = new double[ ParamCount ];
+		NewCosts = new double[ aObjCount > 1 ? aObjCount : 1 ];
 		NewValues = new double[ ParamCount ];
+		NewCns = ( CnsCount > 0 ? new double[ CnsCount ] : NULL );
+		DiscMin = new double[ ParamCount ];
+		DiscCount = new double[ ParamCount ];
+		DiscCountI = new double[ ParamCount ];
 	}
 
 	virtual void deleteBuffers()
@@ -1911,7 +3274,12 @@ protected:
 		delete[] DiffValuesI;
 		delete[] StartParams;
 		delete[] BestValues;
+		delete[] NewCosts;
 		delete[] NewValues;
+		delete[] NewCns;
+		delete[] DiscMin;
+		delete[] DiscCount;
+		delete[] DiscCountI;
 	}
 
 	/**
@@ -1951,13 +3319,27 @@ protected:
 
 	/**
 	 * Function updates values in the DiffValues array, based on values in the
-	 * MinValues and MaxValues arrays.
+	 * MinValues and MaxValues arrays. Also updates value ranges of discrete
+	 * parameters.
 	 */
 
 	void updateDiffValues()
 	{
 		int i;
 
+		if( ParamTypes != NULL )
+		{
+			for( i = 0; i < ParamCount; i++ )
+			{
+				const double lo = ceil( MinValues[ i ]);
+				const double n = floor( MaxValues[ i ]) - lo + 1.0;
+
+				DiscMin[ i ] = lo;
+				DiscCount[ i ] = ( n < 1.0 ? 1.0 : n );
+				DiscCountI[ i ] = 1.0 / DiscCount[ i ];
+			}
+		}
+
 		if( (ptype) 0.25 == 0 )
 		{
 			for( i = 0; i < ParamCount; i++ )
@@ -2046,7 +3428,57 @@ protected:
 
 	double getRealValue( const ptype* const NormParams, const int i ) const
 	{
-		return( MinValues[ i ] + DiffValues[ i ] * NormParams[ i ]);
+		if( ParamTypes == NULL || ParamTypes[ i ] == ptContinuous )
+		{
+			return( MinValues[ i ] + DiffValues[ i ] * NormParams[ i ]);
+		}
+
+		return( DiscMin[ i ] + getDiscIndex( NormParams[ i ], i ));
+	}
+
+	/**
+	 * Function returns the value index of a discrete parameter.
+	 *
+	 * @param v Parameter value, in normalized scale.
+	 * @param i Parameter index.
+	 */
+
+	double getDiscIndex( const ptype v, const int i ) const
+	{
+		const double u = ( (ptype) 0.25 == 0 ? v * MantMultI : (double) v );
+		const double k = floor( u * DiscCount[ i ]);
+
+		return( k < 0.0 ? 0.0 :
+			( k > DiscCount[ i ] - 1.0 ? DiscCount[ i ] - 1.0 : k ));
+	}
+
+	/**
+	 * Function snaps discrete parameters of the specified vector to centers
+	 * of their value bins, so that all vectors that produce the same real
+	 * values are equal. Does nothing if parameter types were not assigned.
+	 *
+	 * @param[in,out] Params Parameter vector, in normalized scale.
+	 */
+
+	void snapParams( ptype* const Params ) const
+	{
+		if( ParamTypes == NULL )
+		{
+			return;
+		}
+
+		int i;
+
+		for( i = 0; i < ParamCount; i++ )
+		{
+			if( ParamTypes[ i ] != ptContinuous )
+			{
+				const double u = ( getDiscIndex( Params[ i ], i ) + 0.5 ) *
+					DiscCountI[ i ];
+
+				Params[ i ] = (ptype) ( (ptype) 0.25 == 0 ? u * MantMult : u );
+			}
+		}
 	}
 
 	/**
@@ -2251,7 +3683,8 @@ protected:
 
 	/**
 	 * Function performs choice selection based on the specified selector, and
-	 * adds the selector to apply list.
+	 * adds the selector to apply list. Selections beyond the MaxApplySels
+	 * limit are not added to the list.
 	 *
 	 * @param Sel Selector object.
 	 * @param rnd PRNG object.
@@ -2260,8 +3693,11 @@ protected:
 	template< class T >
 	int select( T& Sel, CBiteRnd& rnd )
 	{
-		ApplySels[ ApplySelsCount ] = &Sel;
-		ApplySelsCount++;
+		if( ApplySelsCount < MaxApplySels )
+		{
+			ApplySels[ ApplySelsCount ] = &Sel;
+			ApplySelsCount++;
+		}
 
 		return( Sel.select( rnd ));
 	}
@@ -2333,11 +3769,1314 @@ public:
 
 	virtual double optcost( const double* const p )
 	{
-		return( Owner -> optcost( p ));
+		return( Owner -> optrank( p ));
+	}
+
+	virtual void optcns( const double* const p, double* const c )
+	{
+		Owner -> optcns( p, c );
+	}
+
+	virtual void optobjs( const double* const p, double* const objs )
+	{
+		Owner -> optobjs( p, objs );
+	}
+
+	virtual bool isCostBoundUsed() const
+	{
+		return( Owner -> isCostBoundUsed() );
 	}
 
 protected:
 	CBiteOptInterface* Owner; ///< Owner object.
 };
 
+/**
+ * Evaluation cache class. Holds objective function values of bitwise
+ * matching parameter vectors, in a bounded hash table. Uses open addressing
+ * with linear probing, and "clock" (second chance) eviction, when the cache
+ * is full.
+ *
+ * The cache assumes that the objective function stays unchanged. The clear()
+ * function should be called otherwise.
+ *
+ * @tparam ptype Parameter value storage type.
+ */
+
+template< typename ptype >
+class CBiteEvalCache
+{
+public:
+	CBiteEvalCache()
+		: ParamCount( 0 )
+		, BufParamCount( 0 )
+		, Capacity( 0 )
+		, TableMask( -1 )
+		, Table( NULL )
+		, EntParams( NULL )
+		, EntCosts( NULL )
+		, EntHashes( NULL )
+		, EntRefs( NULL )
+	{
+		clear();
+	}
+
+	~CBiteEvalCache()
+	{
+		deleteBuffers();
+	}
+
+	/**
+	 * Function updates dimensions of *this cache, and clears it. Function
+	 * does nothing if dimensions have not changed since the last call.
+	 * Buffers are kept, if the capacity is unchanged, and the parameter
+	 * count does not exceed the one the buffers were allocated for.
+	 *
+	 * @param aParamCount The number of parameters in a vector.
+	 * @param aCapacity The maximal number of vectors to hold. If <= 0, the
+	 * cache is disabled.
+	 */
+
+	void updateDims( const int aParamCount, const int aCapacity )
+	{
+		if( aParamCount == ParamCount && aCapacity == Capacity )
+		{
+			return;
+		}
+
+		if( aCapacity == Capacity && aParamCount <= BufParamCount )
+		{
+			ParamCount = aParamCount;
+			clear();
+
+			return;
+		}
+
+		deleteBuffers();
+
+		ParamCount = aParamCount;
+		BufParamCount = aParamCount;
+		Capacity = ( aCapacity > 0 ? aCapacity : 0 );
+
+		if( Capacity > 0 )
+		{
+			int ts = 16;
+
+			while( ts < Capacity * 2 )
+			{
+				ts <<= 1;
+			}
+
+			TableMask = ts - 1;
+			Table = new int[ ts ];
+			EntParams = new ptype[ (size_t) Capacity * ParamCount ];
+			EntCosts = new double[ Capacity ];
+			EntHashes = new uint64_t[ Capacity ];
+			EntRefs = new uint8_t[ Capacity ];
+		}
+
+		clear();
+	}
+
+	/**
+	 * Function removes all vectors from the cache, and resets hit and miss
+	 * counters.
+	 */
+
+	void clear()
+	{
+		EntCount = 0;
+		ClockPos = 0;
+		HitCount = 0;
+		MissCount = 0;
+
+		int i;
+
+		for( i = 0; i <= TableMask; i++ )
+		{
+			Table[ i ] = -1;
+		}
+	}
+
+	/**
+	 * @return "True" if the cache is enabled.
+	 */
+
+	bool isEnabled() const
+	{
+		return( Capacity > 0 );
+	}
+
+	/**
+	 * Function looks up the specified parameter vector, and updates hit or
+	 * miss counter.
+	 *
+	 * @param Params Parameter vector.
+	 * @param[out] Cost Cached objective function value, if found.
+	 * @return "True" if the vector was found.
+	 */
+
+	bool find( const ptype* const Params, double& Cost )
+	{
+		const int e = findEntry( Params, calcHash( Params ));
+
+		if( e < 0 )
+		{
+			MissCount++;
+			return( false );
+		}
+
+		HitCount++;
+		EntRefs[ e ] = 1;
+		Cost = EntCosts[ e ];
+
+		return( true );
+	}
+
+	/**
+	 * Function inserts the specified parameter vector and its objective
+	 * function value into the cache. When the cache is full, the least
+	 * recently referenced vector is evicted. If the vector is already in the
+	 * cache, its value is updated.
+	 *
+	 * @param Params Parameter vector.
+	 * @param Cost Objective function value.
+	 */
+
+	void insert( const ptype* const Params, const double Cost )
+	{
+		if( Capacity == 0 )
+		{
+			return;
+		}
+
+		const uint64_t h = calcHash( Params );
+		int e = findEntry( Params, h );
+
+		if( e < 0 )
+		{
+			if( EntCount < Capacity )
+			{
+				e = EntCount;
+				EntCount++;
+			}
+			else
+			{
+				e = evictEntry();
+			}
+
+			memcpy( EntParams + (size_t) e * ParamCount, Params,
+				ParamCount * sizeof( Params[ 0 ]));
+
+			EntHashes[ e ] = h;
+
+			int i = (int) ( h & TableMask );
+
+			while( Table[ i ] >= 0 )
+			{
+				i = ( i + 1 ) & TableMask;
+			}
+
+			Table[ i ] = e;
+		}
+
+		EntCosts[ e ] = Cost;
+		EntRefs[ e ] = 0;
+	}
+
+	/**
+	 * @return The number of lookups that found a cached value.
+	 */
+
+	int64_t getHitCount() const
+	{
+		return( HitCount );
+	}
+
+	/**
+	 * @return The number of lookups that did not find a cached value.
+	 */
+
+	int64_t getMissCount() const
+	{
+		return( MissCount );
+	}
+
+protected:
+	int ParamCount; ///< The number of parameters in a vector.
+	int BufParamCount; ///< Parameter count the buffers were allocated for.
+	int Capacity; ///< The maximal number of vectors in the cache.
+	int TableMask; ///< Hash table size minus 1, table size is a power of 2.
+	int* Table; ///< Hash table, holds entry indices, -1 for empty slots.
+	ptype* EntParams; ///< Entries' parameter vectors.
+	double* EntCosts; ///< Entries' objective function values.
+	uint64_t* EntHashes; ///< Entries' hash values.
+	uint8_t* EntRefs; ///< Entries' "referenced" flags, for clock eviction.
+	int EntCount; ///< The number of entries in use.
+	int ClockPos; ///< Clock eviction's position.
+	int64_t HitCount; ///< The number of cache hits.
+	int64_t MissCount; ///< The number of cache misses.
+
+	/**
+	 * Function deletes previously allocated buffers.
+	 */
+
+	void deleteBuffers()
+	{
+		delete[] Table;
+		delete[] EntParams;
+		delete[] EntCosts;
+		delete[] EntHashes;
+		delete[] EntRefs;
+		Table = NULL;
+		EntParams = NULL;
+		EntCosts = NULL;
+		EntHashes = NULL;
+		EntRefs = NULL;
+		TableMask = -1;
+	}
+
+	/**
+	 * Function calculates hash value of the specified parameter vector.
+	 *
+	 * @param Params Parameter vector.
+	 */
+
+	uint64_t calcHash( const ptype* const Params ) const
+	{
+		uint64_t h = (uint64_t) ParamCount;
+		int i;
+
+		for( i = 0; i < ParamCount; i++ )
+		{
+			uint64_t v = 0;
+			memcpy( &v, Params + i, sizeof( Params[ i ]));
+
+			h = ( h ^ v ) * 0x9E3779B97F4A7C15;
+			h ^= h >> 29;
+		}
+
+		return( CBiteRnd :: mix64( h ));
+	}
+
+	/**
+	 * Function returns the index of entry that holds the specified parameter
+	 * vector, or -1, if there is no such entry.
+	 *
+	 * @param Params Parameter vector.
+	 * @param h Vector's hash value.
+	 */
+
+	int findEntry( const ptype* const Params, const uint64_t h ) const
+	{
+		if( Capacity == 0 )
+		{
+			return( -1 );
+		}
+
+		int i = (int) ( h & TableMask );
+
+		while( true )
+		{
+			const int e = Table[ i ];
+
+			if( e < 0 )
+			{
+				return( -1 );
+			}
+
+			if( EntHashes[ e ] == h && memcmp( EntParams +
+				(size_t) e * ParamCount, Params,
+				ParamCount * sizeof( Params[ 0 ])) == 0 )
+			{
+				return( e );
+			}
+
+			i = ( i + 1 ) & TableMask;
+		}
+	}
+
+	/**
+	 * Function selects an entry for eviction via the "clock" algorithm, and
+	 * removes it from the hash table, using backward shift deletion.
+	 *
+	 * @return Index of the freed entry.
+	 */
+
+	int evictEntry()
+	{
+		while( EntRefs[ ClockPos ] != 0 )
+		{
+			EntRefs[ ClockPos ] = 0;
+			ClockPos = ( ClockPos + 1 == Capacity ? 0 : ClockPos + 1 );
+		}
+
+		const int e = ClockPos;
+		ClockPos = ( ClockPos + 1 == Capacity ? 0 : ClockPos + 1 );
+
+		int i = (int) ( EntHashes[ e ] & TableMask );
+
+		while( Table[ i ] != e )
+		{
+			i = ( i + 1 ) & TableMask;
+		}
+
+		int j = i;
+
+		while( true )
+		{
+			j = ( j + 1 ) & TableMask;
+
+			if( Table[ j ] < 0 )
+			{
+				break;
+			}
+
+			const int k = (int) ( EntHashes[ Table[ j ]] & TableMask );
+
+			// Move the entry, if its home slot is not cyclically within
+			// ( i; j ].
+
+			if(( i <= j ) ? ( i >= k || k > j ) : ( i >= k && k > j ))
+			{
+				Table[ i ] = Table[ j ];
+				i = j;
+			}
+		}
+
+		Table[ i ] = -1;
+
+		return( e );
+	}
+};
+
+/**
+ * Pareto archive class. Holds a bounded set of mutually non-dominated
+ * solutions of a multi-objective optimization, in real parameter values.
+ * When the archive is full, the solution with the smallest distance to its
+ * nearest neighbor in the normalized objective space is removed, to keep
+ * the front evenly covered.
+ */
+
+class CBiteParetoArchive
+{
+public:
+	CBiteParetoArchive()
+		: ParamCount( 0 )
+		, ObjCount( 0 )
+		, Capacity( 0 )
+		, Count( 0 )
+		, Buf( NULL )
+		, ObjBuf( NULL )
+	{
+	}
+
+	~CBiteParetoArchive()
+	{
+		delete[] Buf;
+		delete[] ObjBuf;
+	}
+
+	/**
+	 * Function updates dimensions of *this archive, and clears it. Function
+	 * does nothing if dimensions have not changed since the last call.
+	 *
+	 * @param aParamCount The number of parameters.
+	 * @param aObjCount The number of objectives.
+	 * @param aCapacity The maximal number of solutions to hold.
+	 */
+
+	void updateDims( const int aParamCount, const int aObjCount,
+		const int aCapacity )
+	{
+		if( aParamCount == ParamCount && aObjCount == ObjCount &&
+			aCapacity == Capacity )
+		{
+			return;
+		}
+
+		ParamCount = aParamCount;
+		ObjCount = aObjCount;
+		Capacity = aCapacity;
+		ItemLen = aParamCount + aObjCount;
+
+		delete[] Buf;
+		delete[] ObjBuf;
+		Buf = new double[ (size_t) ( aCapacity + 1 ) * ItemLen ];
+		ObjBuf = new double[ aObjCount * 2 ];
+		Count = 0;
+	}
+
+	/**
+	 * Function removes all solutions from the archive.
+	 */
+
+	void clear()
+	{
+		Count = 0;
+	}
+
+	/**
+	 * Function inserts a solution into the archive, if it is not dominated
+	 * by, or equal to, any archived solution. Archived solutions dominated
+	 * by the new solution are removed.
+	 *
+	 * @param Values Parameter values.
+	 * @param Objs Objective values.
+	 * @return "True" if the solution was inserted.
+	 */
+
+	bool insert( const double* const Values, const double* const Objs )
+	{
+		if( Capacity == 0 )
+		{
+			return( false );
+		}
+
+		int i = 0;
+
+		while( i < Count )
+		{
+			const double* const o = getObjs( i );
+
+			if( isDominatedOrEqual( Objs, o ))
+			{
+				return( false );
+			}
+
+			if( isDominatedOrEqual( o, Objs ))
+			{
+				Count--;
+				memcpy( getItem( i ), getItem( Count ),
+					ItemLen * sizeof( Buf[ 0 ]));
+			}
+			else
+			{
+				i++;
+			}
+		}
+
+		double* const it = getItem( Count );
+		memcpy( it, Values, ParamCount * sizeof( it[ 0 ]));
+		memcpy( it + ParamCount, Objs, ObjCount * sizeof( it[ 0 ]));
+		Count++;
+
+		if( Count > Capacity )
+		{
+			const int ri = findMostCrowded();
+			Count--;
+			memcpy( getItem( ri ), getItem( Count ),
+				ItemLen * sizeof( Buf[ 0 ]));
+		}
+
+		return( true );
+	}
+
+	/**
+	 * @return The number of solutions in the archive.
+	 */
+
+	int getCount() const
+	{
+		return( Count );
+	}
+
+	/**
+	 * @param i Solution index, [0; getCount()).
+	 * @return Parameter values of the specified solution.
+	 */
+
+	const double* getValues( const int i ) const
+	{
+		return( Buf + (size_t) i * ItemLen );
+	}
+
+	/**
+	 * @param i Solution index, [0; getCount()).
+	 * @return Objective values of the specified solution.
+	 */
+
+	const double* getObjs( const int i ) const
+	{
+		return( Buf + (size_t) i * ItemLen + ParamCount );
+	}
+
+	/**
+	 * Function returns "true" if objective vector "a" is dominated by, or
+	 * equal to, the objective vector "b", for minimization.
+	 *
+	 * @param a Objective vector.
+	 * @param b Objective vector.
+	 * @param n The number of objectives.
+	 */
+
+	static bool isDominatedOrEqual( const double* const a,
+		const double* const b, const int n )
+	{
+		int k;
+
+		for( k = 0; k < n; k++ )
+		{
+			if( b[ k ] > a[ k ])
+			{
+				return( false );
+			}
+		}
+
+		return( true );
+	}
+
+	/**
+	 * Function returns "true" if objective vector "a" dominates objective
+	 * vector "b", for minimization.
+	 *
+	 * @param a Objective vector.
+	 * @param b Objective vector.
+	 * @param n The number of objectives.
+	 */
+
+	static bool isDominating( const double* const a, const double* const b,
+		const int n )
+	{
+		bool IsBetter = false;
+		int k;
+
+		for( k = 0; k < n; k++ )
+		{
+			if( a[ k ] > b[ k ])
+			{
+				return( false );
+			}
+
+			if( a[ k ] < b[ k ])
+			{
+				IsBetter = true;
+			}
+		}
+
+		return( IsBetter );
+	}
+
+protected:
+	int ParamCount; ///< The number of parameters.
+	int ObjCount; ///< The number of objectives.
+	int Capacity; ///< The maximal number of solutions.
+	int ItemLen; ///< The length of a solution item, in doubles.
+	int Count; ///< The number of solutions in the archive.
+	double* Buf; ///< Solution items: parameter values, then objective
+		///< values. Holds Capacity + 1 items.
+	double* ObjBuf; ///< Objective minimums and scales, ObjCount * 2
+		///< elements.
+
+	double* getItem( const int i ) const
+	{
+		return( Buf + (size_t) i * ItemLen );
+	}
+
+	bool isDominatedOrEqual( const double* const a,
+		const double* const b ) const
+	{
+		return( isDominatedOrEqual( a, b, ObjCount ));
+	}
+
+	/**
+	 * Function returns the index of a solution with the smallest distance to
+	 * its nearest neighbor, in the objective space normalized by the
+	 * archive's objective ranges. Extreme solutions of each objective are
+	 * not selected.
+	 */
+
+	int findMostCrowded() const
+	{
+		double* const MinObj = ObjBuf;
+		double* const ScaleObj = ObjBuf + ObjCount;
+		const int oc = ObjCount;
+		int i;
+		int k;
+
+		for( k = 0; k < oc; k++ )
+		{
+			double mn = getObjs( 0 )[ k ];
+			double mx = mn;
+
+			for( i = 1; i < Count; i++ )
+			{
+				const double v = getObjs( i )[ k ];
+				mn = ( v < mn ? v : mn );
+				mx = ( v > mx ? v : mx );
+			}
+
+			MinObj[ k ] = mn;
+			ScaleObj[ k ] = ( mx > mn ? 1.0 / ( mx - mn ) : 1.0 );
+		}
+
+		int ri = 0;
+		double rd = 1e300;
+
+		for( i = 0; i < Count; i++ )
+		{
+			const double* const oi = getObjs( i );
+			bool IsExtreme = false;
+
+			for( k = 0; k < oc; k++ )
+			{
+				if( oi[ k ] == MinObj[ k ])
+				{
+					IsExtreme = true;
+					break;
+				}
+			}
+
+			if( IsExtreme )
+			{
+				continue;
+			}
+
+			double nd = 1e300;
+			int j;
+
+			for( j = 0; j < Count; j++ )
+			{
+				if( j == i )
+				{
+					continue;
+				}
+
+				const double* const oj = getObjs( j );
+				double d = 0.0;
+
+				for( k = 0; k < oc; k++ )
+				{
+					const double v = ( oi[ k ] - oj[ k ]) * ScaleObj[ k ];
+					d += v * v;
+				}
+
+				nd = ( d < nd ? d : nd );
+			}
+
+			if( nd < rd )
+			{
+				rd = nd;
+				ri = i;
+			}
+		}
+
+		return( ri );
+	}
+};
+
+/**
+ * Solution generator statistics collector. Records, for each generator of an
+ * optimizer, the number of its selections, the number of its solutions
+ * accepted into the population, the histogram of population ranks at which
+ * solutions were accepted, and the time spent in the generator. Time spent
+ * in the objective function is recorded separately. Time is measured in
+ * ticks: CPU timestamp counter cycles on x86, nanoseconds otherwise.
+ * Statistics are collected by optimizers this object was assigned to, see
+ * CBiteOpt::setGenStats().
+ */
+
+class CBiteGenStats
+{
+public:
+	static const int MaxGenCount = 32; ///< The maximal number of generators.
+	static const int RankBinCount = 8; ///< The number of bins in acceptance
+		///< rank histograms; a bin corresponds to a range of population
+		///< positions, relative to the current population size.
+
+	CBiteGenStats()
+		: GenCount( 0 )
+		, GenNames( NULL )
+	{
+		clear();
+	}
+
+	/**
+	 * Function resets all statistics to zero.
+	 */
+
+	void clear()
+	{
+		memset( SelCounts, 0, sizeof( SelCounts ));
+		memset( AcceptCounts, 0, sizeof( AcceptCounts ));
+		memset( RankHists, 0, sizeof( RankHists ));
+		memset( GenTicks, 0, sizeof( GenTicks ));
+		EvalTicks = 0;
+	}
+
+	/**
+	 * Function assigns generator names, called by the optimizer. Does not
+	 * reset statistics.
+	 *
+	 * @param aGenCount The number of generators, <= MaxGenCount.
+	 * @param aGenNames Generator names, should be static constants.
+	 */
+
+	void setGenNames( const int aGenCount, const char* const* aGenNames )
+	{
+		GenCount = aGenCount;
+		GenNames = aGenNames;
+	}
+
+	/**
+	 * @return The number of generators.
+	 */
+
+	int getGenCount() const
+	{
+		return( GenCount );
+	}
+
+	/**
+	 * @return Name of the specified generator.
+	 * @param gi Generator index.
+	 */
+
+	const char* getGenName( const int gi ) const
+	{
+		return( GenNames[ gi ]);
+	}
+
+	/**
+	 * @return The number of selections of the specified generator. Includes
+	 * solutions that were regenerated before evaluation, due to
+	 * pre-screening, or duplicate discrete solutions.
+	 * @param gi Generator index.
+	 */
+
+	int64_t getSelCount( const int gi ) const
+	{
+		return( SelCounts[ gi ]);
+	}
+
+	/**
+	 * @return The number of solutions of the specified generator accepted
+	 * into the population.
+	 * @param gi Generator index.
+	 */
+
+	int64_t getAcceptCount( const int gi ) const
+	{
+		return( AcceptCounts[ gi ]);
+	}
+
+	/**
+	 * @return Acceptance rank histogram of the specified generator,
+	 * RankBinCount elements, the best ranks first.
+	 * @param gi Generator index.
+	 */
+
+	const int64_t* getRankHist( const int gi ) const
+	{
+		return( RankHists[ gi ]);
+	}
+
+	/**
+	 * @return Ticks spent in the specified generator, excluding objective
+	 * function evaluations.
+	 * @param gi Generator index.
+	 */
+
+	int64_t getGenTicks( const int gi ) const
+	{
+		return( GenTicks[ gi ]);
+	}
+
+	/**
+	 * @return Ticks spent in objective function evaluations.
+	 */
+
+	int64_t getEvalTicks() const
+	{
+		return( EvalTicks );
+	}
+
+	/**
+	 * @return The current timestamp, in ticks.
+	 */
+
+	static int64_t getTimestamp()
+	{
+	#if defined( BITEOPT_RDTSC )
+		return( (int64_t) __rdtsc() );
+	#else // defined( BITEOPT_RDTSC )
+		return( (int64_t) std :: chrono :: duration_cast<
+			std :: chrono :: nanoseconds >( std :: chrono :: steady_clock ::
+			now().time_since_epoch() ).count() );
+	#endif // defined( BITEOPT_RDTSC )
+	}
+
+	/**
+	 * Function records a selection of a generator.
+	 *
+	 * @param gi Generator index.
+	 * @param Ticks Ticks spent in the generator.
+	 */
+
+	void addSel( const int gi, const int64_t Ticks )
+	{
+		SelCounts[ gi ]++;
+		GenTicks[ gi ] += Ticks;
+	}
+
+	/**
+	 * Function records an acceptance of generator's solution into the
+	 * population.
+	 *
+	 * @param gi Generator index.
+	 * @param p Population position of the accepted solution, [0; PopSize).
+	 * @param PopSize Current population size.
+	 */
+
+	void addAccept( const int gi, const int p, const int PopSize )
+	{
+		AcceptCounts[ gi ]++;
+		RankHists[ gi ][ (int) ( (int64_t) p * RankBinCount / PopSize )]++;
+	}
+
+	/**
+	 * Function records time spent in an objective function evaluation.
+	 *
+	 * @param Ticks Ticks spent.
+	 */
+
+	void addEvalTicks( const int64_t Ticks )
+	{
+		EvalTicks += Ticks;
+	}
+
+protected:
+	int GenCount; ///< The number of generators.
+	const char* const* GenNames; ///< Generator names.
+	int64_t SelCounts[ MaxGenCount ]; ///< Selection counts.
+	int64_t AcceptCounts[ MaxGenCount ]; ///< Acceptance counts.
+	int64_t RankHists[ MaxGenCount ][ RankBinCount ]; ///< Acceptance rank
+		///< histograms.
+	int64_t GenTicks[ MaxGenCount ]; ///< Ticks spent in generators.
+	int64_t EvalTicks; ///< Ticks spent in objective function evaluations.
+};
+
+/**
+ * Timeline tracer that records optimizer phases as spans and instant
+ * events, and writes them in the Chrome trace event JSON format, viewable
+ * in chrome://tracing or Perfetto. Events are recorded into per-thread
+ * buffers without locking, so several threads may record into the same
+ * tracer concurrently. Each recording thread claims its own buffer on its
+ * first event; up to MaxThreadCount threads are supported, events of
+ * further threads are dropped.
+ *
+ * Event names should be static strings that need no JSON escaping.
+ */
+
+class CBiteTracer
+{
+public:
+	static const int MaxThreadCount = 64; ///< The maximal number of
+		///< recording threads.
+	static const int BlockLen = 4096; ///< The number of events in a buffer
+		///< block.
+
+	/**
+	 * Constructor.
+	 *
+	 * @param aMaxEventCount The maximal number of events recorded per
+	 * thread; further events are dropped.
+	 */
+
+	CBiteTracer( const int64_t aMaxEventCount = (int64_t) 1 << 22 )
+		: MaxEventCount( aMaxEventCount )
+		, Serial( getNextSerial() )
+		, TimeOrigin( getTimestamp() )
+		, ThreadCount( 0 )
+		, LostCount( 0 )
+	{
+		int i;
+
+		for( i = 0; i < MaxThreadCount; i++ )
+		{
+			Bufs[ i ].store( NULL, std :: memory_order_relaxed );
+		}
+	}
+
+	~CBiteTracer()
+	{
+		int i;
+
+		for( i = 0; i < MaxThreadCount; i++ )
+		{
+			CThreadBuf* const b = Bufs[ i ].load( std :: memory_order_acquire );
+
+			if( b == NULL )
+			{
+				continue;
+			}
+
+			CBlock* bl = b -> First;
+
+			while( bl != NULL )
+			{
+				CBlock* const nb = bl -> Next;
+				delete bl;
+				bl = nb;
+			}
+
+			delete b;
+		}
+	}
+
+	/**
+	 * @return The current timestamp, in nanoseconds.
+	 */
+
+	static int64_t getTimestamp()
+	{
+		return( (int64_t) std :: chrono :: duration_cast<
+			std :: chrono :: nanoseconds >( std :: chrono :: steady_clock ::
+			now().time_since_epoch() ).count() );
+	}
+
+	/**
+	 * Function records a span that ends at the current time, into the
+	 * calling thread's buffer.
+	 *
+	 * @param Name Span name.
+	 * @param t0 Span's start timestamp, obtained via getTimestamp().
+	 */
+
+	void addSpan( const char* const Name, const int64_t t0 )
+	{
+		const int64_t t = getTimestamp();
+
+		addEvent( Name, t0, t - t0 );
+	}
+
+	/**
+	 * Function records an instant event at the current time, into the
+	 * calling thread's buffer.
+	 *
+	 * @param Name Event name.
+	 */
+
+	void addInstant( const char* const Name )
+	{
+		addEvent( Name, getTimestamp(), -1 );
+	}
+
+	/**
+	 * @return The number of events recorded by all threads. Should not be
+	 * called while events are being recorded.
+	 */
+
+	int64_t getEventCount() const
+	{
+		int64_t s = 0;
+		int i;
+
+		for( i = 0; i < MaxThreadCount; i++ )
+		{
+			const CThreadBuf* const b =
+				Bufs[ i ].load( std :: memory_order_acquire );
+
+			if( b != NULL )
+			{
+				s += b -> Count;
+			}
+		}
+
+		return( s );
+	}
+
+	/**
+	 * @return The number of events dropped due to the MaxEventCount and
+	 * MaxThreadCount limits. Should not be called while events are being
+	 * recorded.
+	 */
+
+	int64_t getDroppedCount() const
+	{
+		int64_t s = LostCount.load( std :: memory_order_relaxed );
+		int i;
+
+		for( i = 0; i < MaxThreadCount; i++ )
+		{
+			const CThreadBuf* const b =
+				Bufs[ i ].load( std :: memory_order_acquire );
+
+			if( b != NULL )
+			{
+				s += b -> DropCount;
+			}
+		}
+
+		return( s );
+	}
+
+	/**
+	 * Function writes all recorded events to a JSON file. Timestamps are
+	 * relative to *this object's construction. Should not be called while
+	 * events are being recorded.
+	 *
+	 * @param FileName Name of the file to (over)write.
+	 * @return "True" on success, "false" on a file error.
+	 */
+
+	bool write( const char* const FileName ) const
+	{
+		FILE* const f = fopen( FileName, "w" );
+
+		if( f == NULL )
+		{
+			return( false );
+		}
+
+		fprintf( f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n" );
+		bool IsFirst = true;
+		int i;
+
+		for( i = 0; i < MaxThreadCount; i++ )
+		{
+			const CThreadBuf* const b =
+				Bufs[ i ].load( std :: memory_order_acquire );
+
+			if( b == NULL )
+			{
+				continue;
+			}
+
+			fprintf( f, "%s{\"name\":\"thread_name\",\"ph\":\"M\","
+				"\"pid\":1,\"tid\":%i,\"args\":{\"name\":\"biteopt %i\"}}",
+				( IsFirst ? "" : ",\n" ), i, i );
+
+			IsFirst = false;
+
+			const CBlock* bl = b -> First;
+			int64_t c = b -> Count;
+
+			while( bl != NULL && c > 0 )
+			{
+				const int bc = ( c > BlockLen ? BlockLen : (int) c );
+				c -= bc;
+				int j;
+
+				for( j = 0; j < bc; j++ )
+				{
+					const CEvent& e = bl -> Events[ j ];
+					const double ts = ( e.Start - TimeOrigin ) * 0.001;
+
+					if( e.Dur < 0 )
+					{
+						fprintf( f, ",\n{\"name\":\"%s\",\"cat\":\"biteopt\","
+							"\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%i,"
+							"\"ts\":%.3f}", e.Name, i, ts );
+					}
+					else
+					{
+						fprintf( f, ",\n{\"name\":\"%s\",\"cat\":\"biteopt\","
+							"\"ph\":\"X\",\"pid\":1,\"tid\":%i,\"ts\":%.3f,"
+							"\"dur\":%.3f}", e.Name, i, ts, e.Dur * 0.001 );
+					}
+				}
+
+				bl = bl -> Next;
+			}
+		}
+
+		fprintf( f, "\n]}\n" );
+
+		const bool IsOk = ( ferror( f ) == 0 );
+
+		return( fclose( f ) == 0 && IsOk );
+	}
+
+protected:
+	/**
+	 * Recorded event.
+	 */
+
+	struct CEvent
+	{
+		const char* Name; ///< Event name.
+		int64_t Start; ///< Start timestamp, in nanoseconds.
+		int64_t Dur; ///< Duration, in nanoseconds; -1 for instant events.
+	};
+
+	/**
+	 * Block of a per-thread event buffer.
+	 */
+
+	struct CBlock
+	{
+		CEvent Events[ BlockLen ]; ///< Events.
+		CBlock* Next; ///< Next block, NULL if none.
+	};
+
+	/**
+	 * Per-thread event buffer, only accessed by the owning thread while
+	 * events are being recorded.
+	 */
+
+	struct CThreadBuf
+	{
+		const void* Owner; ///< Owning thread's identifier.
+		CBlock* First; ///< The first block.
+		CBlock* Last; ///< The last block.
+		int LastCount; ///< The number of events in the last block.
+		int64_t Count; ///< The number of events recorded.
+		int64_t DropCount; ///< The number of events dropped.
+	};
+
+	/**
+	 * Per-thread cache of the latest tracer's buffer.
+	 */
+
+	struct CThreadCache
+	{
+		uint64_t Serial; ///< Serial number of the tracer, 0 if none.
+		CThreadBuf* Buf; ///< The thread's buffer in the tracer, NULL if
+			///< the buffer could not be claimed.
+	};
+
+	int64_t MaxEventCount; ///< The maximal number of events per thread.
+	uint64_t Serial; ///< Serial number of *this tracer, to distinguish it
+		///< from tracers previously located at the same address.
+	int64_t TimeOrigin; ///< Timestamp of *this object's construction.
+	std :: atomic< CThreadBuf* > Bufs[ MaxThreadCount ]; ///< Per-thread
+		///< buffers, NULL if not yet claimed.
+	std :: atomic< int > ThreadCount; ///< The number of claimed buffer
+		///< slots, may exceed MaxThreadCount.
+	std :: atomic< int64_t > LostCount; ///< The number of events dropped
+		///< by threads that could not claim a buffer.
+
+	/**
+	 * @return A new, non-zero tracer serial number.
+	 */
+
+	static uint64_t getNextSerial()
+	{
+		static std :: atomic< uint64_t > s( 0 );
+
+		return( ++s );
+	}
+
+	/**
+	 * @return The calling thread's cache.
+	 */
+
+	static CThreadCache& getThreadCache()
+	{
+		static thread_local CThreadCache c = { 0, NULL };
+
+		return( c );
+	}
+
+	/**
+	 * Function returns the calling thread's buffer, claiming a new one on
+	 * the thread's first event.
+	 *
+	 * @return The buffer, NULL if MaxThreadCount was reached.
+	 */
+
+	CThreadBuf* getThreadBuf()
+	{
+		CThreadCache& tc = getThreadCache();
+
+		if( tc.Serial == Serial )
+		{
+			return( tc.Buf );
+		}
+
+		// The thread may have recorded into another tracer in between.
+
+		const void* const Owner = &tc;
+		const int tcnt = ThreadCount.load( std :: memory_order_acquire );
+		int i;
+
+		for( i = 0; i < tcnt && i < MaxThreadCount; i++ )
+		{
+			CThreadBuf* const b = Bufs[ i ].load( std :: memory_order_acquire );
+
+			if( b != NULL && b -> Owner == Owner )
+			{
+				tc.Serial = Serial;
+				tc.Buf = b;
+
+				return( b );
+			}
+		}
+
+		const int bi = ThreadCount.fetch_add( 1, std :: memory_order_acq_rel );
+		CThreadBuf* b = NULL;
+
+		if( bi < MaxThreadCount )
+		{
+			b = new CThreadBuf;
+			b -> Owner = Owner;
+			b -> First = NULL;
+			b -> Last = NULL;
+			b -> LastCount = BlockLen;
+			b -> Count = 0;
+			b -> DropCount = 0;
+
+			Bufs[ bi ].store( b, std :: memory_order_release );
+		}
+
+		tc.Serial = Serial;
+		tc.Buf = b;
+
+		return( b );
+	}
+
+	/**
+	 * Function records an event into the calling thread's buffer.
+	 *
+	 * @param Name Event name.
+	 * @param Start Start timestamp.
+	 * @param Dur Duration, -1 for instant events.
+	 */
+
+	void addEvent( const char* const Name, const int64_t Start,
+		const int64_t Dur )
+	{
+		CThreadBuf* const b = getThreadBuf();
+
+		if( b == NULL )
+		{
+			LostCount.fetch_add( 1, std :: memory_order_relaxed );
+			return;
+		}
+
+		if( b -> Count >= MaxEventCount )
+		{
+			b -> DropCount++;
+			return;
+		}
+
+		if( b -> LastCount == BlockLen )
+		{
+			CBlock* const bl = new CBlock;
+			bl -> Next = NULL;
+
+			if( b -> Last == NULL )
+			{
+				b -> First = bl;
+			}
+			else
+			{
+				b -> Last -> Next = bl;
+			}
+
+			b -> Last = bl;
+			b -> LastCount = 0;
+		}
+
+		CEvent& e = b -> Last -> Events[ b -> LastCount ];
+		e.Name = Name;
+		e.Start = Start;
+		e.Dur = Dur;
+
+		b -> LastCount++;
+		b -> Count++;
+	}
+};
+
 #endif // BITEAUX_INCLUDED
@@ -0,0 +1,554 @@
+//$ nocpp
+
+/**
+ * @file bitelog.h
+ *
+ * @version 2024.6
+ *
+ * @brief The inclusion file for the CBiteEvalLog class.
+ *
+ * @section license License
+ *
+ * Copyright (c) 2016-2024 Aleksey Vaneev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef BITELOG_INCLUDED
+#define BITELOG_INCLUDED
+
+#include "biteaux.h"
+#include <stddef.h>
+#include <thread>
+
+/**
+ * Evaluation log class. Records evaluated parameter vectors, their costs,
+ * solution generator identifiers and timestamps into a binary file, for
+ * later replay of the optimization history.
+ *
+ * The file starts with a header: the 8-byte "BITELOG1" magic value,
+ * followed by 32-bit unsigned header size, record size, parameter count,
+ * population size (0 until the log is closed) and generator count values,
+ * and 4 reserved bytes; then generator names follow, as zero-terminated
+ * strings, padded with zeroes to the header size, a multiple of 8. The
+ * header is followed by fixed-size records (see CRecHdr), so the file can
+ * be memory-mapped as an array of records. All values are in the native
+ * byte order.
+ *
+ * Records are added into per-thread lock-free single-producer
+ * single-consumer ring buffers, which are drained to the file by a
+ * background writer thread, so the evaluating threads do not wait for
+ * file I/O. A thread only waits if its ring buffer is full, i.e. if the
+ * disk cannot keep up with evaluations. Records of different threads may
+ * appear in the file out of time order. Up to MaxThreadCount threads can
+ * add records, records of further threads are dropped.
+ */
+
+class CBiteEvalLog
+{
+public:
+	static const int GenInit = -1; ///< Generator identifier of initial
+		///< population evaluations.
+	static const int GenPolish = -2; ///< Generator identifier of polishing
+		///< phase evaluations.
+	static const int MaxThreadCount = 64; ///< The maximal number of threads
+		///< adding records.
+
+	CBiteEvalLog()
+		: File( NULL )
+		, ParamCount( 0 )
+		, RecSize( 0 )
+		, RingLen( 0 )
+		, PopSize( 0 )
+		, Serial( 0 )
+		, TimeOrigin( 0 )
+		, ThreadCount( 0 )
+		, DropCount( 0 )
+		, IsStopping( false )
+		, IsFailed( false )
+	{
+		int i;
+
+		for( i = 0; i < MaxThreadCount; i++ )
+		{
+			Rings[ i ].store( NULL, std :: memory_order_relaxed );
+		}
+	}
+
+	~CBiteEvalLog()
+	{
+		close();
+	}
+
+	/**
+	 * Function creates (overwrites) a log file, and starts the writer
+	 * thread. Does nothing and returns "false", if the log is already open.
+	 *
+	 * @param FileName Log file name.
+	 * @param aParamCount The number of parameters in the objective function.
+	 * @param GenCount The number of solution generators.
+	 * @param GenNames Solution generator names, GenCount elements.
+	 * @param RingSize Per-thread ring buffer size, in bytes.
+	 * @return "True" if the log was opened successfully.
+	 */
+
+	bool open( const char* const FileName, const int aParamCount,
+		const int GenCount, const char* const* const GenNames,
+		const int RingSize = 1 << 22 )
+	{
+		if( File != NULL || aParamCount < 1 )
+		{
+			return( false );
+		}
+
+		File = fopen( FileName, "wb" );
+
+		if( File == NULL )
+		{
+			return( false );
+		}
+
+		ParamCount = aParamCount;
+		RecSize = (int) ( sizeof( CRecHdr ) + ParamCount * sizeof( double ));
+		RingLen = 16;
+
+		while( RingLen * 2 <= RingSize / RecSize )
+		{
+			RingLen *= 2;
+		}
+
+		PopSize = 0;
+		Serial = getNextSerial();
+		TimeOrigin = CBiteTracer :: getTimestamp();
+		ThreadCount.store( 0, std :: memory_order_relaxed );
+		DropCount.store( 0, std :: memory_order_relaxed );
+		IsStopping.store( false, std :: memory_order_relaxed );
+		IsFailed.store( false, std :: memory_order_relaxed );
+
+		uint32_t NamesSize = 0;
+		int i;
+
+		for( i = 0; i < GenCount; i++ )
+		{
+			NamesSize += (uint32_t) strlen( GenNames[ i ]) + 1;
+		}
+
+		CFileHdr h;
+		memcpy( h.Magic, "BITELOG1", 8 );
+		h.HeaderSize = (uint32_t) (( sizeof( h ) + NamesSize + 7 ) & ~7 );
+		h.RecSize = (uint32_t) RecSize;
+		h.ParamCount = (uint32_t) ParamCount;
+		h.PopSize = 0;
+		h.GenCount = (uint32_t) GenCount;
+		h.Reserved = 0;
+
+		bool IsOk = ( fwrite( &h, sizeof( h ), 1, File ) == 1 );
+
+		for( i = 0; i < GenCount; i++ )
+		{
+			IsOk &= ( fwrite( GenNames[ i ], strlen( GenNames[ i ]) + 1, 1,
+				File ) == 1 );
+		}
+
+		const uint64_t z = 0;
+		const size_t pc = h.HeaderSize - sizeof( h ) - NamesSize;
+
+		if( pc > 0 )
+		{
+			IsOk &= ( fwrite( &z, pc, 1, File ) == 1 );
+		}
+
+		if( !IsOk )
+		{
+			fclose( File );
+			File = NULL;
+
+			return( false );
+		}
+
+		Writer = std :: thread( &CBiteEvalLog :: writerFunc, this );
+
+		return( true );
+	}
+
+	/**
+	 * Function stops the writer thread after it has written all pending
+	 * records, and closes the log file. Should not be called while records
+	 * are being added.
+	 *
+	 * @return "True" if all records and the header were written
+	 * successfully.
+	 */
+
+	bool close()
+	{
+		if( File == NULL )
+		{
+			return( true );
+		}
+
+		IsStopping.store( true, std :: memory_order_release );
+		Writer.join();
+
+		bool IsOk = !IsFailed.load( std :: memory_order_relaxed );
+
+		// Patch population size into the header.
+
+		const uint32_t ps = (uint32_t) PopSize;
+
+		IsOk &= ( fseek( File, (long) offsetof( CFileHdr, PopSize ),
+			SEEK_SET ) == 0 );
+
+		IsOk &= ( fwrite( &ps, sizeof( ps ), 1, File ) == 1 );
+		IsOk &= ( fclose( File ) == 0 );
+		File = NULL;
+
+		int i;
+
+		for( i = 0; i < MaxThreadCount; i++ )
+		{
+			CRing* const r = Rings[ i ].load( std :: memory_order_relaxed );
+
+			if( r != NULL )
+			{
+				delete[] r -> Buf;
+				delete r;
+				Rings[ i ].store( NULL, std :: memory_order_relaxed );
+			}
+		}
+
+		return( IsOk );
+	}
+
+	/**
+	 * @return "True" if the log is open.
+	 */
+
+	bool isOpen() const
+	{
+		return( File != NULL );
+	}
+
+	/**
+	 * Function assigns population size, to be written into the header when
+	 * the log is closed, for population reconstruction on replay.
+	 *
+	 * @param aPopSize Population size.
+	 */
+
+	void setPopSize( const int aPopSize )
+	{
+		PopSize = aPopSize;
+	}
+
+	/**
+	 * Function adds a record to the calling thread's ring buffer. Should
+	 * only be called while the log is open.
+	 *
+	 * @param x Parameter vector, ParamCount elements.
+	 * @param Cost Cost of the parameter vector.
+	 * @param Gen Identifier of the generator that produced the vector, see
+	 * CBiteOpt::EGenerator, GenInit and GenPolish.
+	 * @param Attempt Optimization attempt index.
+	 */
+
+	void add( const double* const x, const double Cost, const int Gen,
+		const int Attempt )
+	{
+		const int64_t t = CBiteTracer :: getTimestamp();
+		CRing* const r = getRing();
+
+		if( r == NULL )
+		{
+			DropCount.fetch_add( 1, std :: memory_order_relaxed );
+			return;
+		}
+
+		const uint64_t h = r -> Head.load( std :: memory_order_relaxed );
+
+		while( h - r -> Tail.load( std :: memory_order_acquire ) >=
+			(uint64_t) RingLen )
+		{
+			std :: this_thread :: yield();
+		}
+
+		uint8_t* const d = r -> Buf + ( h & ( RingLen - 1 )) * RecSize;
+
+		CRecHdr rh;
+		rh.Time = t - TimeOrigin;
+		rh.Gen = Gen;
+		rh.Attempt = Attempt;
+		rh.Cost = Cost;
+
+		memcpy( d, &rh, sizeof( rh ));
+		memcpy( d + sizeof( rh ), x, ParamCount * sizeof( x[ 0 ]));
+
+		r -> Head.store( h + 1, std :: memory_order_release );
+	}
+
+	/**
+	 * @return The number of records dropped due to the MaxThreadCount
+	 * limit.
+	 */
+
+	int64_t getDroppedCount() const
+	{
+		return( DropCount.load( std :: memory_order_relaxed ));
+	}
+
+protected:
+	/**
+	 * File header, followed by generator names.
+	 */
+
+	struct CFileHdr
+	{
+		char Magic[ 8 ]; ///< "BITELOG1".
+		uint32_t HeaderSize; ///< Header size, including generator names.
+		uint32_t RecSize; ///< Record size.
+		uint32_t ParamCount; ///< The number of parameters.
+		uint32_t PopSize; ///< Population size.
+		uint32_t GenCount; ///< The number of generator names.
+		uint32_t Reserved; ///< Reserved, 0.
+	};
+
+	/**
+	 * Record header, followed by ParamCount parameter values.
+	 */
+
+	struct CRecHdr
+	{
+		int64_t Time; ///< Evaluation's end time, in nanoseconds since the
+			///< log was opened.
+		int32_t Gen; ///< Generator identifier.
+		int32_t Attempt; ///< Optimization attempt index.
+		double Cost; ///< Cost.
+	};
+
+	/**
+	 * Per-thread ring buffer. Head is only modified by the owning thread,
+	 * Tail only by the writer thread.
+	 */
+
+	struct CRing
+	{
+		const void* Owner; ///< Owning thread's identifier.
+		uint8_t* Buf; ///< Records, RingLen elements.
+		std :: atomic< uint64_t > Head; ///< The number of records added.
+		std :: atomic< uint64_t > Tail; ///< The number of records written.
+	};
+
+	/**
+	 * Per-thread cache of the latest log's ring buffer.
+	 */
+
+	struct CThreadCache
+	{
+		uint64_t Serial; ///< Serial number of the log, 0 if none.
+		CRing* Ring; ///< The thread's ring buffer in the log, NULL if the
+			///< ring buffer could not be claimed.
+	};
+
+	FILE* File; ///< Log file, NULL if the log is not open.
+	int ParamCount; ///< The number of parameters.
+	int RecSize; ///< Record size, in bytes.
+	int RingLen; ///< Ring buffer length, in records, a power of 2.
+	int PopSize; ///< Population size, written into the header on close.
+	uint64_t Serial; ///< Serial number of the log's latest opening.
+	int64_t TimeOrigin; ///< Timestamp of the log's opening.
+	std :: atomic< CRing* > Rings[ MaxThreadCount ]; ///< Per-thread ring
+		///< buffers, NULL if not yet claimed.
+	std :: atomic< int > ThreadCount; ///< The number of claimed ring
+		///< buffer slots, may exceed MaxThreadCount.
+	std :: atomic< int64_t > DropCount; ///< The number of dropped records.
+	std :: atomic< bool > IsStopping; ///< "True" if the writer thread
+		///< should stop, after writing all pending records.
+	std :: atomic< bool > IsFailed; ///< "True" if a write error occurred.
+	std :: thread Writer; ///< Writer thread.
+
+	/**
+	 * @return A new, non-zero log serial number.
+	 */
+
+	static uint64_t getNextSerial()
+	{
+		static std :: atomic< uint64_t > s( 0 );
+
+		return( ++s );
+	}
+
+	/**
+	 * @return The calling thread's cache.
+	 */
+
+	static CThreadCache& getThreadCache()
+	{
+		static thread_local CThreadCache c = { 0, NULL };
+
+		return( c );
+	}
+
+	/**
+	 * Function returns the calling thread's ring buffer, claiming a new one
+	 * on the thread's first record.
+	 *
+	 * @return The ring buffer, NULL if MaxThreadCount was reached.
+	 */
+
+	CRing* getRing()
+	{
+		CThreadCache& tc = getThreadCache();
+
+		if( tc.Serial == Serial )
+		{
+			return( tc.Ring );
+		}
+
+		// The thread may have added records to another log in between.
+
+		const void* const Owner = &tc;
+		const int tcnt = ThreadCount.load( std :: memory_order_acquire );
+		int i;
+
+		for( i = 0; i < tcnt && i < MaxThreadCount; i++ )
+		{
+			CRing* const r = Rings[ i ].load( std :: memory_order_acquire );
+
+			if( r != NULL && r -> Owner == Owner )
+			{
+				tc.Serial = Serial;
+				tc.Ring = r;
+
+				return( r );
+			}
+		}
+
+		const int ri = ThreadCount.fetch_add( 1, std :: memory_order_acq_rel );
+		CRing* r = NULL;
+
+		if( ri < MaxThreadCount )
+		{
+			r = new CRing;
+			r -> Owner = Owner;
+			r -> Buf = new uint8_t[ (size_t) RingLen * RecSize ];
+			r -> Head.store( 0, std :: memory_order_relaxed );
+			r -> Tail.store( 0, std :: memory_order_relaxed );
+
+			Rings[ ri ].store( r, std :: memory_order_release );
+		}
+
+		tc.Serial = Serial;
+		tc.Ring = r;
+
+		return( r );
+	}
+
+	/**
+	 * Function writes all pending records of all ring buffers to the file.
+	 *
+	 * @return The number of records written.
+	 */
+
+	int64_t drain()
+	{
+		int64_t c = 0;
+		int i;
+
+		for( i = 0; i < MaxThreadCount; i++ )
+		{
+			CRing* const r = Rings[ i ].load( std :: memory_order_acquire );
+
+			if( r == NULL )
+			{
+				continue;
+			}
+
+			uint64_t t = r -> Tail.load( std :: memory_order_relaxed );
+			const uint64_t h = r -> Head.load( std :: memory_order_acquire );
+
+			while( t < h )
+			{
+				const uint64_t ti = t & ( RingLen - 1 );
+				uint64_t n = h - t;
+
+				if( n > RingLen - ti )
+				{
+					n = RingLen - ti;
+				}
+
+				if( fwrite( r -> Buf + ti * RecSize, RecSize, (size_t) n,
+					File ) != (size_t) n )
+				{
+					IsFailed.store( true, std :: memory_order_relaxed );
+				}
+
+				t += n;
+				c += (int64_t) n;
+			}
+
+			r -> Tail.store( t, std :: memory_order_release );
+		}
+
+		return( c );
+	}
+
+	/**
+	 * Writer thread's function. Drains ring buffers, and flushes the file
+	 * when there is nothing to write.
+	 */
+
+	void writerFunc()
+	{
+		bool IsDirty = false;
+
+		while( true )
+		{
+			// The stop flag is read before draining, so that records added
+			// before close() are always written.
+
+			const bool DoStop = IsStopping.load( std :: memory_order_acquire );
+
+			if( drain() > 0 )
+			{
+				IsDirty = true;
+				continue;
+			}
+
+			if( DoStop )
+			{
+				break;
+			}
+
+			if( IsDirty )
+			{
+				fflush( File );
+				IsDirty = false;
+			}
+
+			std :: this_thread :: sleep_for( std :: chrono :: milliseconds( 1 ));
+		}
+
+		if( fflush( File ) != 0 )
+		{
+			IsFailed.store( true, std :: memory_order_relaxed );
+		}
+	}
+};
+
+#endif // BITELOG_INCLUDED
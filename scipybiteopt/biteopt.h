@@ -38,7 +38,10 @@
 #define BITEOPT_VERSION "2024.6"
 
 #include "spheropt.h"
+#include "nmsopt.h"
 #include "mbopt.h"
+#include "bitestore.h"
+#include "bitelog.h"
 
 /**
  * BiteOpt optimization class. Implements a stochastic non-linear
@@ -56,6 +59,23 @@ public:
 	CBiteOpt()
 		: ParOpt( this )
 		, ParOpt2( this )
+		, EvalCache( NULL )
+		, DoPrescreen( false )
+		, PrescreenSaved( 0 )
+		, DupSaved( 0 )
+		, CostBound( 1e300 )
+		, DeltaParent( NULL )
+		, GenStats( NULL )
+		, SelGen( 0 )
+		, Tracer( NULL )
+		, ParetoArchive( NULL )
+		, MODomMat( NULL )
+		, MODomCnt( NULL )
+		, MOQueue( NULL )
+		, MOFront( NULL )
+		, MOObjScale( NULL )
+		, MinSolThrs( NULL )
+		, MinSolThrsLen( 0 )
 	{
 		addSel( MethodSel, "MethodSel" );
 		addSel( M1Sel, "M1Sel" );
@@ -106,6 +126,24 @@ public:
 		addSel( Gen8SpanSel[ 1 ], "Gen8SpanSel[ 1 ]" );
 	}
 
+	virtual ~CBiteOpt()
+	{
+		delete[] MODomMat;
+		delete[] MODomCnt;
+		delete[] MOQueue;
+		delete[] MOFront;
+		delete[] MOObjScale;
+
+		int i;
+
+		for( i = 0; i < MinSolThrsLen; i++ )
+		{
+			delete[] MinSolThrs[ i ];
+		}
+
+		delete[] MinSolThrs;
+	}
+
 	/**
 	 * Function updates dimensionality of *this object. Function does nothing
 	 * if dimensionality has not changed since the last call. This function
@@ -114,19 +152,24 @@ public:
 	 * @param aParamCount The number of parameters being optimized.
 	 * @param PopSize0 The number of elements in population to use. If set to
 	 * 0 or negative, the default formula will be used.
+	 * @param aCnsCount The number of constraints, see the optcns() function.
+	 * @param aObjCount The number of objectives. If above 1, the optobjs()
+	 * function is used for evaluation, see the setParetoArchive() function.
 	 */
 
-	void updateDims( const int aParamCount, const int PopSize0 = 0 )
+	void updateDims( const int aParamCount, const int PopSize0 = 0,
+		const int aCnsCount = 0, const int aObjCount = 1 )
 	{
 		const int aPopSize = ( PopSize0 > 0 ? PopSize0 :
 			calcPopSizeBiteOpt( aParamCount ));
 
-		if( aParamCount == ParamCount && aPopSize == PopSize )
+		if( aParamCount == ParamCount && aPopSize == PopSize &&
+			aCnsCount == CnsCount && aObjCount == ObjCount )
 		{
 			return;
 		}
 
-		initBuffers( aParamCount, aPopSize );
+		initBuffers( aParamCount, aPopSize, aCnsCount, aObjCount );
 		setParPopCount( 5 );
 
 		ParOpt.updateDims( aParamCount, 11 + aPopSize / 3 );
@@ -135,8 +178,357 @@ public:
 		ParOpt2.updateDims( aParamCount, aPopSize );
 		ParOpt2Pop.initBuffers( aParamCount, aPopSize );
 
-		OldPops[ 0 ].initBuffers( aParamCount, aPopSize );
-		OldPops[ 1 ].initBuffers( aParamCount, aPopSize );
+		OldPops[ 0 ].initBuffers( aParamCount, aPopSize, aCnsCount,
+			aObjCount );
+
+		OldPops[ 1 ].initBuffers( aParamCount, aPopSize, aCnsCount,
+			aObjCount );
+	}
+
+	/**
+	 * Function assigns a Pareto archive to use in multi-objective mode
+	 * (ObjCount > 1). In this mode, objective values of each solution are
+	 * obtained via the optobjs() function, and its rank is calculated
+	 * against the current population: the integer part is the index of the
+	 * non-dominated front the solution belongs to, and the fractional part
+	 * is a crowding term, which is lower for solutions farther from their
+	 * nearest neighbor in the same front. Ranks of the population are
+	 * recalculated via the full non-dominated sorting once per population
+	 * turnover. Evaluation cache, pre-screening and parallel optimizers are
+	 * not used in this mode, and getBestCost() returns the rank. Feasible
+	 * evaluated solutions are offered to the archive.
+	 *
+	 * @param aParetoArchive Pareto archive, NULL to disable archiving. The
+	 * archive should be initialized to *this object's ParamCount and
+	 * ObjCount. The archive can be shared by several optimizers.
+	 */
+
+	void setParetoArchive( CBiteParetoArchive* const aParetoArchive )
+	{
+		ParetoArchive = aParetoArchive;
+	}
+
+	/**
+	 * Function assigns an evaluation cache to use, see optrank(). The cache
+	 * is queried before evaluating a solution, and evaluated solutions are
+	 * put into the cache, except those with costs above the cost bound (see
+	 * getCostBound()), which may be partial, if the objective function uses
+	 * the bound (see isCostBoundUsed()). Not used in multi-objective
+	 * mode. The cache can be shared by several optimizers that evaluate the
+	 * same objective function.
+	 *
+	 * @param aEvalCache Evaluation cache, NULL to disable caching. The cache
+	 * should be initialized to *this object's ParamCount.
+	 */
+
+	void setEvalCache( CBiteEvalCache< double >* const aEvalCache )
+	{
+		EvalCache = aEvalCache;
+	}
+
+	/**
+	 * Function enables or disables surrogate pre-screening of the generated
+	 * solutions. When enabled, the cost of each newly-generated solution is
+	 * predicted via inverse distance weighting of its nearest neighbors in
+	 * the current and old populations. A solution predicted to be worse
+	 * than the current population's worst solution is discarded without
+	 * evaluation, and another one is generated, up to PrescreenMaxRejects
+	 * times in a row. A random fraction of such solutions is evaluated
+	 * anyway, to keep the prediction honest. The model needs no separate
+	 * training: it reads the populations that are updated by optimize().
+	 * Useful for expensive objective functions only.
+	 *
+	 * @param aDoPrescreen "True" to enable pre-screening.
+	 */
+
+	void setPrescreen( const bool aDoPrescreen )
+	{
+		DoPrescreen = aDoPrescreen;
+	}
+
+	/**
+	 * @return The number of objective function evaluations avoided via
+	 * pre-screening, since *this object's construction.
+	 */
+
+	int64_t getPrescreenSaved() const
+	{
+		return( PrescreenSaved );
+	}
+
+	/**
+	 * Function assigns parameter types, see CBiteOptBase::setParamTypes().
+	 * Generated solutions are snapped to discrete values before evaluation.
+	 * A solution equal to a population's solution is not evaluated: another
+	 * solution is generated, up to DupMaxRegens times in a row, after which
+	 * the solution is rejected, as if its cost was taken from the
+	 * population.
+	 *
+	 * @param aParamTypes Parameter types, NULL if all parameters are
+	 * continuous.
+	 */
+
+	virtual void setParamTypes( const int* const aParamTypes )
+	{
+		CBiteOptBase< ptype > :: setParamTypes( aParamTypes );
+
+		ParOpt.setParamTypes( aParamTypes );
+		ParOpt2.setParamTypes( aParamTypes );
+	}
+
+	/**
+	 * @return The number of objective function evaluations of duplicate
+	 * discrete solutions avoided, since *this object's construction.
+	 */
+
+	int64_t getDupSaved() const
+	{
+		return( DupSaved );
+	}
+
+	/**
+	 * Solution generator identifiers, see setGenStats().
+	 */
+
+	enum EGenerator
+	{
+		genSol1, // generateSol1().
+		genSol2, // generateSol2().
+		genSol2b, // generateSol2b().
+		genSol2c, // generateSol2c().
+		genSol2d, // generateSol2d().
+		genSol3, // generateSol3().
+		genSol4, // generateSol4().
+		genSol5, // generateSol5().
+		genSol5b, // generateSol5b().
+		genSol5c, // generateSol5c().
+		genSol6, // generateSol6().
+		genSol7, // generateSol7().
+		genSol8, // generateSol8().
+		genSol9, // generateSol9().
+		genSol10, // generateSol10().
+		genSol11, // generateSol11().
+		genSol12, // generateSol12().
+		genSol13, // generateSol13().
+		genSolPar, // generateSolPar().
+		GenCount // The number of generators.
+	};
+
+	/**
+	 * @return Names of solution generators, GenCount elements.
+	 */
+
+	static const char* const* getGenNames()
+	{
+		static const char* const GenNames[ GenCount ] = {
+			"generateSol1", "generateSol2", "generateSol2b", "generateSol2c",
+			"generateSol2d", "generateSol3", "generateSol4", "generateSol5",
+			"generateSol5b", "generateSol5c", "generateSol6", "generateSol7",
+			"generateSol8", "generateSol9", "generateSol10", "generateSol11",
+			"generateSol12", "generateSol13", "generateSolPar" };
+
+		return( GenNames );
+	}
+
+	/**
+	 * Function assigns a solution generator statistics collector. The
+	 * collector may be shared by several optimizers that do not run
+	 * concurrently. Objective function evaluations of parallel optimizers
+	 * are included into evaluation ticks, and not into generator's ticks.
+	 *
+	 * @param aGenStats Statistics collector, NULL to disable statistics
+	 * collection.
+	 */
+
+	void setGenStats( CBiteGenStats* const aGenStats )
+	{
+		GenStats = aGenStats;
+
+		if( GenStats != NULL )
+		{
+			GenStats -> setGenNames( GenCount, getGenNames() );
+		}
+	}
+
+	/**
+	 * Function assigns a timeline tracer. Solution generators, objective
+	 * function evaluations, population updates, centroid recalculations,
+	 * and parallel optimizer steps and restarts are then recorded as
+	 * events. The tracer may be shared by several optimizers.
+	 *
+	 * @param aTracer Tracer, NULL to disable tracing.
+	 */
+
+	void setTracer( CBiteTracer* const aTracer )
+	{
+		Tracer = aTracer;
+	}
+
+	/**
+	 * @return Generator of the solution being currently evaluated, see
+	 * EGenerator; -1 during initial population evaluations.
+	 */
+
+	int getEvalGen() const
+	{
+		return( DoInitEvals ? -1 : SelGen );
+	}
+
+	/**
+	 * Function evaluates the rank of the parameter vector, see
+	 * CBiteOptBase::optrank(). Solutions of all sources (generators, the
+	 * initial population, and parallel optimizers) are looked up in the
+	 * evaluation cache first, if it is in use; the cache is keyed on the
+	 * real parameter vector, which is passed to the objective function.
+	 */
+
+	virtual double optrank( const double* const p )
+	{
+		const bool UseCache = ( EvalCache != NULL && ObjCount == 1 );
+		double r;
+
+		if( UseCache && EvalCache -> find( p, r ))
+		{
+			if( CnsCount > 0 )
+			{
+				optcns( p, NewCns );
+			}
+
+			return( r );
+		}
+
+		r = evalRank( p );
+
+		if( UseCache && ( r <= CostBound || !isCostBoundUsed() ))
+		{
+			EvalCache -> insert( p, r );
+		}
+
+		return( r );
+	}
+
+	/**
+	 * Function evaluates the rank of the parameter vector via the
+	 * CBiteOptBase::optrank() function, and updates evaluation statistics.
+	 *
+	 * @param p Parameter vector to evaluate.
+	 */
+
+	double evalRank( const double* const p )
+	{
+		BITEOPT_STAT( EvalCount, 1 );
+
+		if( GenStats == NULL && Tracer == NULL )
+		{
+			return( CBiteOptBase< ptype > :: optrank( p ));
+		}
+
+		const int64_t t0 = ( GenStats != NULL ?
+			CBiteGenStats :: getTimestamp() : 0 );
+
+		const int64_t tt0 = ( Tracer != NULL ?
+			CBiteTracer :: getTimestamp() : 0 );
+
+		const double r = CBiteOptBase< ptype > :: optrank( p );
+
+		if( GenStats != NULL )
+		{
+			GenStats -> addEvalTicks( CBiteGenStats :: getTimestamp() - t0 );
+		}
+
+		if( Tracer != NULL )
+		{
+			Tracer -> addSpan( "eval", tt0 );
+		}
+
+		return( r );
+	}
+
+	virtual double getCostBound() const
+	{
+		return( CostBound );
+	}
+
+	using CBiteOptBase< ptype > :: getPopSize;
+	using CBiteOptBase< ptype > :: getCurPopSize;
+	using CBiteOptBase< ptype > :: calcParamSpread;
+
+	/**
+	 * Function checks the population collapse stopping criteria. Should be
+	 * called no more often than once per population turnover, as it scans
+	 * the whole population. Recalculates the centroid, if it is out of date.
+	 *
+	 * @param ftol Relative rank spread threshold, see
+	 * CBitePop::calcRankSpread(); 0 disables the criterion. Ignored in
+	 * multi-objective mode.
+	 * @param xtol Parameter spread threshold, relative to parameter ranges,
+	 * see CBitePop::calcParamSpread(); 0 disables the criterion.
+	 * @return "True" if all enabled criteria are met; "false" if no
+	 * criteria are enabled, or the population was not yet filled.
+	 */
+
+	bool isConverged( const double ftol, const double xtol )
+	{
+		const bool UseFtol = ( ftol > 0.0 && ObjCount == 1 );
+
+		if( DoInitEvals || ( !UseFtol && xtol <= 0.0 ))
+		{
+			return( false );
+		}
+
+		if( UseFtol && calcRankSpread() > ftol )
+		{
+			return( false );
+		}
+
+		if( xtol <= 0.0 )
+		{
+			return( true );
+		}
+
+		if( NeedCentUpdate )
+		{
+			updateCentroid();
+		}
+
+		return( calcParamSpread() <= xtol );
+	}
+
+	virtual int getDeltaParent( double* const ParentValues,
+		double* const ParentCost, int* const Changed ) const
+	{
+		if( DeltaParent == NULL )
+		{
+			return( -1 );
+		}
+
+		// Infeasible, NaN and bound-exceeding parents hold a penalty rank
+		// instead of an objective value.
+
+		const double pc = *getObjPtr( (ptype*) DeltaParent );
+
+		if( pc >= 1e200 )
+		{
+			return( -1 );
+		}
+
+		int c = 0;
+		int i;
+
+		for( i = 0; i < ParamCount; i++ )
+		{
+			ParentValues[ i ] = getRealValue( DeltaParent, i );
+
+			if( TmpParams[ i ] != DeltaParent[ i ])
+			{
+				Changed[ c ] = i;
+				c++;
+			}
+		}
+
+		*ParentCost = pc;
+
+		return( c );
 	}
 
 	/**
@@ -166,6 +558,19 @@ public:
 		ParOpt2Pop.resetCurPopPos();
 		OldPops[ 0 ].resetCurPopPos();
 		OldPops[ 1 ].resetCurPopPos();
+		dropParPopsShare();
+
+		if( ObjCount > 1 )
+		{
+			int k;
+
+			for( k = 0; k < ObjCount; k++ )
+			{
+				MOObjScale[ k ] = 1.0;
+			}
+
+			MOSortCount = 0;
+		}
 	}
 
 	/**
@@ -186,7 +591,7 @@ public:
 	 * more efficiently.
 	 */
 
-	int optimize( CBiteRnd& rnd, CBiteOpt* const PushOpt = NULL )
+	int64_t optimize( CBiteRnd& rnd, CBiteOpt* const PushOpt = NULL )
 	{
 		int i;
 
@@ -195,164 +600,197 @@ public:
 			ptype* const Params = getCurParams();
 
 			genInitParams( rnd, Params );
+			snapParams( Params );
+
+			if( ObjCount > 1 )
+			{
+				const double r = evalRankMO();
 
-			NewCosts[ 0 ] = fixCostNaN( optcost( NewValues ));
-			updateBestCost( NewCosts[ 0 ], NewValues,
-				updatePop( NewCosts[ 0 ], Params ));
+				updateBestCost( r, NewValues,
+					updatePop( r, Params, false, 0, NewCns, NewCosts ));
+			}
+			else
+			{
+				NewCosts[ 0 ] = fixCostNaN( optrank( NewValues ));
+				updateBestCost( NewCosts[ 0 ], NewValues,
+					updatePop( NewCosts[ 0 ], Params, false, 0, NewCns ));
+			}
 
 			if( CurPopPos == PopSize )
 			{
+				if( ObjCount > 1 )
+				{
+					rankPopMO();
+				}
+
+				const int64_t tt0 = ( Tracer != NULL ?
+					CBiteTracer :: getTimestamp() : 0 );
+
 				updateCentroid();
 
-				for( i = 0; i < ParPopCount; i++ )
+				if( Tracer != NULL )
 				{
-					ParPops[ i ] -> copy( *this );
+					Tracer -> addSpan( "updateCentroid", tt0 );
 				}
 
+				shareParPops();
+
 				DoInitEvals = false;
 			}
 
 			return( 0 );
 		}
 
-		DoEval = true;
-
-		const int SelMethod = select( MethodSel, rnd );
+		int Attempt = 0;
+		int DupAttempt = 0;
+		ptype* DupParams; // Population's solution equal to the new one.
 
-		if( SelMethod == 0 )
-		{
-			generateSol2( rnd );
-		}
-		else
-		if( SelMethod == 1 )
+		while( true )
 		{
-			const int SelM1 = select( M1Sel, rnd );
+			DoEval = true;
+			DeltaParent = NULL;
+			DupParams = NULL;
 
-			if( SelM1 == 0 )
-			{
-				const int SelM1A = select( M1ASel, rnd );
+			const int64_t tt0 = ( Tracer != NULL ?
+				CBiteTracer :: getTimestamp() : 0 );
 
-				if( SelM1A == 0 )
-				{
-					generateSol2b( rnd );
-				}
-				else
-				if( SelM1A == 1 )
-				{
-					generateSol2c( rnd );
-				}
-				else
-				{
-					generateSol2d( rnd );
-				}
+			if( GenStats == NULL )
+			{
+				generateSolSel( rnd );
 			}
 			else
-			if( SelM1 == 1 )
 			{
-				const int SelM1B = select( M1BSel, rnd );
+				generateSolStat( rnd );
+			}
 
-				if( SelM1B == 0 )
-				{
-					generateSol4( rnd );
-				}
-				else
-				if( SelM1B == 1 )
-				{
-					generateSol5b( rnd );
-				}
-				else
-				if( SelM1B == 2 )
-				{
-					generateSol5c( rnd );
-				}
-				else
-				{
-					generateSol13( rnd );
-				}
+			if( Tracer != NULL )
+			{
+				Tracer -> addSpan( getGenNames()[ SelGen ], tt0 );
 			}
-			else
-			if( SelM1 == 2 )
+
+			if( !DoEval )
 			{
-				const int SelM1C = select( M1CSel, rnd );
+				break;
+			}
 
-				if( SelM1C == 0 )
+			// Wrap parameter values so that they stay in the [0; 1] range.
+
+			for( i = 0; i < ParamCount; i++ )
+			{
+				TmpParams[ i ] = wrapParam( rnd, TmpParams[ i ]);
+				NewValues[ i ] = getRealValue( TmpParams, i );
+			}
+
+			if( ParamTypes != NULL )
+			{
+				snapParams( TmpParams );
+
+				if( ObjCount == 1 )
 				{
-					generateSol5( rnd );
+					DupParams = findPopDup( TmpParams );
 				}
-				else
-				if( SelM1C == 1 )
+
+				if( DupParams != NULL )
 				{
-					generateSol10( rnd );
-				}
-				else
-				{
-					generateSol11( rnd );
+					DupSaved++;
+
+					if( DupAttempt < DupMaxRegens )
+					{
+						// Generators that produced a duplicate are
+						// penalized, as on a rejection.
+
+						applySelsDecr( rnd );
+						DupAttempt++;
+						continue;
+					}
+
+					break;
 				}
 			}
-			else
+
+			if( !DoPrescreen || ObjCount > 1 ||
+				Attempt == PrescreenMaxRejects ||
+				rnd.getInt( PrescreenAuditRate ) == 0 ||
+				predictRank( TmpParams ) <=
+				*getRankPtr( getParamsOrdered( CurPopSize1 )))
 			{
-				generateSol6( rnd );
+				break;
 			}
+
+			// The solution is predicted to be rejected by updatePop(),
+			// generate another one. Its generators are penalized, as on a
+			// rejection.
+
+			applySelsDecr( rnd );
+			Attempt++;
+			PrescreenSaved++;
 		}
-		else
-		if( SelMethod == 2 )
+
+		// Rank of the new solution, differs from its cost in multi-objective
+		// mode.
+
+		double UpdRank;
+
+		if( DupParams != NULL )
 		{
-			if( select( M2Sel, rnd ))
-			{
-				generateSol1( rnd );
-			}
-			else
-			{
-				const int SelM2B = select( M2BSel, rnd );
+			// The solution is known, take its rank from the population.
 
-				if( SelM2B == 0 )
-				{
-					generateSol3( rnd );
-				}
-				else
-				if( SelM2B == 1 )
-				{
-					generateSol7( rnd );
-				}
-				else
-				if( SelM2B == 2 )
-				{
-					generateSol8( rnd );
-				}
-				else
-				if( SelM2B == 3 )
-				{
-					generateSol9( rnd );
-				}
-				else
-				{
-					generateSol12( rnd );
-				}
-			}
+			UpdRank = *getRankPtr( DupParams );
+			DeltaParent = NULL;
 		}
 		else
+		if( DoEval && ObjCount > 1 )
 		{
-			generateSolPar( rnd );
-		}
+			UpdRank = evalRankMO();
+			DeltaParent = NULL;
 
+			LastCosts = NewCosts;
+			LastValues = NewValues;
+		}
+		else
 		if( DoEval )
 		{
 			// Evaluate objective function with new parameters, if the
 			// solution was not provided by the parallel optimizer.
-			// Wrap parameter values so that they stay in the [0; 1] range.
 
-			for( i = 0; i < ParamCount; i++ )
-			{
-				TmpParams[ i ] = wrapParam( rnd, TmpParams[ i ]);
-				NewValues[ i ] = getRealValue( TmpParams, i );
-			}
+			// The solution is rejected by updatePop(), if its cost is
+			// above the worst population's rank.
+
+			CostBound = *getRankPtr( getParamsOrdered( CurPopSize1 ));
+			NewCosts[ 0 ] = fixCostNaN( optrank( NewValues ));
+			CostBound = 1e300;
+
+			DeltaParent = NULL;
 
-			NewCosts[ 0 ] = fixCostNaN( optcost( NewValues ));
 			LastCosts = NewCosts;
 			LastValues = NewValues;
+			UpdRank = NewCosts[ 0 ];
+		}
+		else
+		{
+			UpdRank = LastCosts[ 0 ];
+		}
+
+		const double* const UpdObjs = ( ObjCount > 1 ? NewCosts : NULL );
+
+		// Duplicate solutions are rejected, as they do not change the
+		// population.
+
+		const int64_t tt0 = ( Tracer != NULL ?
+			CBiteTracer :: getTimestamp() : 0 );
+
+		const int p = ( DupParams != NULL ? PopSize :
+			updatePop( UpdRank, TmpParams, true, 3, NewCns, UpdObjs ));
+
+		if( Tracer != NULL )
+		{
+			Tracer -> addSpan( "updatePop", tt0 );
 		}
 
-		const int p = updatePop( LastCosts[ 0 ], TmpParams, true, 3 );
+		if( GenStats != NULL && p <= CurPopSize1 )
+		{
+			GenStats -> addAccept( SelGen, p, CurPopSize );
+		}
 
 		if( p > CurPopSize1 )
 		{
@@ -374,30 +812,38 @@ public:
 		}
 		else
 		{
-			updateBestCost( LastCosts[ 0 ], LastValues, p );
+			updateBestCost( UpdRank, LastValues, p );
 			applySelsIncr( rnd, 1.0 - p * CurPopSizeI );
 
 			StallCount = 0;
 
 			ptype* const OldParams = getParamsOrdered( CurPopSize1 );
 
+			const double* const OldCns = ( CnsCount > 0 ?
+				getCnsPtr( OldParams ) : NULL );
+
+			const double* const OldObjs = ( ObjCount > 1 ?
+				getObjPtr( OldParams ) : NULL );
+
 			if( rnd.get() < ParamCountI )
 			{
-				OldPops[ 0 ].updatePop( *getObjPtr( OldParams ), OldParams,
-					false );
+				OldPops[ 0 ].updatePop( *getRankPtr( OldParams ), OldParams,
+					false, 0, OldCns, OldObjs );
 			}
 
 			if( rnd.get() < 2.0 * ParamCountI )
 			{
-				OldPops[ 1 ].updatePop( *getObjPtr( OldParams ), OldParams,
-					false );
+				OldPops[ 1 ].updatePop( *getRankPtr( OldParams ), OldParams,
+					false, 0, OldCns, OldObjs );
 			}
 
 			if( PushOpt != NULL && PushOpt != this &&
 				!PushOpt -> DoInitEvals && p > 1 )
 			{
-				PushOpt -> updatePop( LastCosts[ 0 ], TmpParams, true, 3 );
-				PushOpt -> updateParPop( LastCosts[ 0 ], TmpParams );
+				PushOpt -> updatePop( UpdRank, TmpParams, true, 3, NewCns,
+					UpdObjs );
+
+				PushOpt -> updateParPop( UpdRank, TmpParams );
 			}
 
 			if( DoEval && CurPopSize > PopSize / 2 )
@@ -413,7 +859,17 @@ public:
 
 		// "Diverging populations" technique.
 
-		updateParPop( LastCosts[ 0 ], TmpParams );
+		updateParPop( UpdRank, TmpParams );
+
+		if( ObjCount > 1 && p <= CurPopSize1 )
+		{
+			MOSortCount++;
+
+			if( MOSortCount >= CurPopSize )
+			{
+				rankPopMO();
+			}
+		}
 
 		return( StallCount );
 	}
@@ -471,1419 +927,3945 @@ protected:
 	CBitePop ParOpt2Pop; ///< Population of parallel optimizer 2's solutions.
 		///< Includes only its solutions.
 	int UseParOpt; ///< Parallel optimizer currently being in use.
-
-	/**
-	 * Function updates an appropriate parallel population.
-	 *
-	 * @param UpdCost Cost of the new solution.
-	 * @param UpdParams New parameter values.
-	 */
-
-	void updateParPop( const double UpdCost, const ptype* const UpdParams )
+	CBiteEvalCache< double >* EvalCache; ///< Evaluation cache, NULL if not in
+		///< use.
+	bool DoPrescreen; ///< "True" if surrogate pre-screening is enabled.
+	int64_t PrescreenSaved; ///< The number of evaluations avoided via
+		///< pre-screening.
+	int64_t DupSaved; ///< The number of evaluations of duplicate discrete
+		///< solutions avoided.
+	static const int DupMaxRegens = 8; ///< The maximal number of consecutive
+		///< regenerations of duplicate solutions.
+	double CostBound; ///< Cost upper bound of the solution being currently
+		///< evaluated, see getCostBound().
+	const ptype* DeltaParent; ///< The parent of the solution being
+		///< currently generated or evaluated, NULL if there is no single
+		///< parent, see getDeltaParent().
+	CBiteGenStats* GenStats; ///< Solution generator statistics collector,
+		///< NULL if not in use.
+	int SelGen; ///< Generator selected by the latest generateSolSel()
+		///< function call, see EGenerator.
+	CBiteTracer* Tracer; ///< Timeline tracer, NULL if not in use.
+	static const int PrescreenMaxRejects = 4; ///< The maximal number of
+		///< consecutive pre-screening rejections.
+	static const int PrescreenAuditRate = 8; ///< 1 of this number of
+		///< solutions is evaluated without pre-screening.
+	static const int PrescreenNeighCount = 4; ///< The number of nearest
+		///< neighbors used for prediction.
+	CBiteParetoArchive* ParetoArchive; ///< Pareto archive, NULL if not in
+		///< use.
+	uint8_t* MODomMat; ///< Dominance matrix of the population, PopSize *
+		///< PopSize elements, used by the rankPopMO() function.
+	int* MODomCnt; ///< Domination counters of population's solutions.
+	int* MOQueue; ///< Population's solution indices, ordered by front.
+	int* MOFront; ///< Front indices of population's solutions, -1 for
+		///< infeasible solutions.
+	double* MOObjScale; ///< Objective value scales of the population,
+		///< ObjCount elements, updated by the rankPopMO() function.
+	int MOSortCount; ///< The number of solutions accepted since the last
+		///< rankPopMO() function call.
+	static const int MinSolThrLen = 32; ///< The maximal number of thresholds
+		///< in a getMinSolIndex() table; higher indices are calculated
+		///< directly.
+	uint64_t** MinSolThrs; ///< getMinSolIndex() threshold tables, per
+		///< population size, NULL if not yet calculated, see
+		///< getMinSolThr().
+	int MinSolThrsLen; ///< The length of the MinSolThrs array.
+
+	virtual void initBuffers( const int aParamCount, const int aPopSize,
+		const int aCnsCount = 0, const int aObjCount = 1 )
 	{
-		const int p = getMinDistParPop( UpdCost, UpdParams );
+		CBiteOptBase< ptype > :: initBuffers( aParamCount, aPopSize,
+			aCnsCount, aObjCount );
 
-		if( p >= 0 )
+		if( aObjCount > 1 && !BufReused )
 		{
-			ParPops[ p ] -> updatePop( UpdCost, UpdParams, true, 0 );
+			MODomMat = new uint8_t[ (size_t) aPopSize * aPopSize ];
+			MODomCnt = new int[ aPopSize ];
+			MOQueue = new int[ aPopSize ];
+			MOFront = new int[ aPopSize ];
+			MOObjScale = new double[ aObjCount ];
 		}
 	}
 
+	virtual void deleteBuffers()
+	{
+		CBiteOptBase< ptype > :: deleteBuffers();
+
+		delete[] MODomMat;
+		delete[] MODomCnt;
+		delete[] MOQueue;
+		delete[] MOFront;
+		delete[] MOObjScale;
+		MODomMat = NULL;
+		MODomCnt = NULL;
+		MOQueue = NULL;
+		MOFront = NULL;
+		MOObjScale = NULL;
+	}
+
 	/**
-	 * Function selects a parallel population to use for solution generation.
-	 * With certain probability, *this object's own population will be
-	 * returned instead of parallel population.
+	 * Function calculates the squared distance between objective vectors,
+	 * in the normalized objective space.
 	 *
-	 * @param gi Solution generator index (0-7).
-	 * @param rnd PRNG object.
+	 * @param a Objective vector.
+	 * @param b Objective vector.
 	 */
 
-	CBitePop& selectParPop( const int gi, CBiteRnd& rnd )
+	double calcObjDistMO( const double* const a, const double* const b ) const
 	{
-		if( select( ParPopPSel[ gi ], rnd ))
+		double d = 0.0;
+		int k;
+
+		for( k = 0; k < ObjCount; k++ )
 		{
-			return( *ParPops[ rnd.getInt( ParPopCount )]);
+			const double v = ( a[ k ] - b[ k ]) * MOObjScale[ k ];
+			d += v * v;
 		}
 
-		return( *this );
+		return( d );
 	}
 
 	/**
-	 * Function selects an alternative, parallel optimizer's, population, to
-	 * use in some solution generators.
+	 * Function evaluates the solution in the NewValues array in
+	 * multi-objective mode. Objective values are stored into the NewCosts
+	 * array; constraint values, if any, into the NewCns array. Infeasible
+	 * solutions are not passed to optobjs(), their objective values are set
+	 * to 1e300, and their rank is based on constraint violation.
 	 *
-	 * @param gi Solution generator index (0-3).
-	 * @param rnd PRNG object.
+	 * @return Rank of the solution, see the calcRankMO() function.
 	 */
 
-	CBitePop& selectAltPop( const int gi, CBiteRnd& rnd )
+	double evalRankMO()
 	{
-		if( select( AltPopPSel, rnd ))
+		const int64_t t0 = ( GenStats != NULL ?
+			CBiteGenStats :: getTimestamp() : 0 );
+
+		const int64_t tt0 = ( Tracer != NULL ?
+			CBiteTracer :: getTimestamp() : 0 );
+
+		int k;
+
+		if( CnsCount > 0 )
 		{
-			if( select( AltPopSel[ gi ], rnd ))
+			optcns( NewValues, NewCns );
+
+			const double r = calcCnsRank( NewCns, CnsCount );
+
+			if( r > 0.0 )
 			{
-				if( ParOptPop.getCurPopPos() >= CurPopSize )
+				for( k = 0; k < ObjCount; k++ )
 				{
-					return( ParOptPop );
+					NewCosts[ k ] = 1e300;
 				}
-			}
-			else
-			{
-				if( ParOpt2Pop.getCurPopPos() >= CurPopSize )
+
+				if( GenStats != NULL )
 				{
-					return( ParOpt2Pop );
+					GenStats -> addEvalTicks(
+						CBiteGenStats :: getTimestamp() - t0 );
+				}
+
+				if( Tracer != NULL )
+				{
+					Tracer -> addSpan( "eval", tt0 );
 				}
+
+				return( r );
 			}
 		}
 
-		return( *this );
+		optobjs( NewValues, NewCosts );
+		BITEOPT_STAT( EvalCount, 1 );
+
+		if( GenStats != NULL )
+		{
+			GenStats -> addEvalTicks( CBiteGenStats :: getTimestamp() - t0 );
+		}
+
+		if( Tracer != NULL )
+		{
+			Tracer -> addSpan( "eval", tt0 );
+		}
+
+		for( k = 0; k < ObjCount; k++ )
+		{
+			NewCosts[ k ] = fixCostNaN( NewCosts[ k ]);
+		}
+
+		if( ParetoArchive != NULL )
+		{
+			ParetoArchive -> insert( NewValues, NewCosts );
+		}
+
+		return( calcRankMO( NewCosts ));
 	}
 
 	/**
-	 * Function returns a dynamically-selected minimal population index, used
-	 * in some solution generation methods.
+	 * Function calculates rank of a feasible solution against the current
+	 * population, incrementally. The solution's front index is one past the
+	 * deepest front of the population's solutions that dominate it. Fronts
+	 * of the population are those assigned by the latest rankPopMO() call,
+	 * or by this function on insertion.
 	 *
-	 * @param gi Solution generator index (0-3).
-	 * @param rnd PRNG object.
-	 * @param ps Population size.
+	 * @param Objs Objective values of the solution.
 	 */
 
-	int getMinSolIndex( const int gi, CBiteRnd& rnd, const int ps )
+	double calcRankMO( const double* const Objs ) const
 	{
-		static const double pp[ 4 ] = { 0.05, 0.125, 0.25, 0.5 };
-		const double r = ps * rnd.getPow( ps *
-			pp[ select( MinSolPwrSel[ gi ], rnd )]);
+		const int n = ( DoInitEvals ? CurPopPos : CurPopSize );
+		int f = 0;
+		int j;
 
-		static const double rm[ 4 ] = { 0.0, 0.125, 0.25, 0.5 };
+		for( j = 0; j < n; j++ )
+		{
+			ptype* const pp = getParamsOrdered( j );
+			const double r = *getRankPtr( pp );
+
+			if( r < 1e200 && r >= f && CBiteParetoArchive :: isDominating(
+				getObjPtr( pp ), Objs, ObjCount ))
+			{
+				f = (int) r + 1;
+			}
+		}
+
+		double nd = 1e300;
+
+		for( j = 0; j < n; j++ )
+		{
+			ptype* const pp = getParamsOrdered( j );
+			const double r = *getRankPtr( pp );
+
+			// Solutions dominated by the new solution are not its
+			// neighbors, as they move to further fronts.
+
+			if( r >= f && r < f + 1 && !CBiteParetoArchive :: isDominating(
+				Objs, getObjPtr( pp ), ObjCount ))
+			{
+				const double d = calcObjDistMO( getObjPtr( pp ), Objs );
+				nd = ( d < nd ? d : nd );
+			}
+		}
 
-		return( (int) ( r * rm[ select( MinSolMulSel[ gi ], rnd )]));
+		return( f + 1.0 / ( 2.0 + sqrt( nd )));
 	}
 
 	/**
-	 * The original "bitmask inversion with random move" solution generator.
-	 * Most of the time adjusts only a single parameter of a better solution,
-	 * yet manages to produce excellent "reference points".
+	 * Function recalculates ranks of the current population via the fast
+	 * non-dominated sorting (O(ObjCount*CurPopSize^2) complexity), and
+	 * reorders the population by the new ranks. Infeasible solutions retain
+	 * their ranks. Also updates objective scales and the best solution.
 	 */
 
-	void generateSol1( CBiteRnd& rnd )
+	void rankPopMO()
 	{
-		ptype* const Params = TmpParams;
-
-		const CBitePop& ParPop = selectParPop( 0, rnd );
-		const int ParPopSize = ParPop.getCurPopSize();
-
-		copyParams( Params, ParPop.getParamsOrdered(
-			getMinSolIndex( 0, rnd, ParPopSize )));
-
-		// Select a single random parameter or all parameters for further
-		// operations.
+		const int n = CurPopSize;
+		int i;
+		int j;
+		int k;
 
-		int a;
-		int b;
-		bool DoAllp = false;
+		MOSortCount = 0;
+		unshareParPops(); // Ranks are changed in place.
 
-		if( rnd.get() < 1.8 * ParamCountI )
+		for( k = 0; k < ObjCount; k++ )
 		{
-			if( select( Gen1AllpSel, rnd ))
+			double mn = 1e300;
+			double mx = -1e300;
+
+			for( i = 0; i < n; i++ )
 			{
-				DoAllp = true;
+				ptype* const pp = getParamsOrdered( i );
+
+				if( *getRankPtr( pp ) < 1e200 )
+				{
+					const double v = getObjPtr( pp )[ k ];
+					mn = ( v < mn ? v : mn );
+					mx = ( v > mx ? v : mx );
+				}
 			}
+
+			MOObjScale[ k ] = ( mx > mn ? 1.0 / ( mx - mn ) : 1.0 );
 		}
 
-		if( DoAllp )
+		for( i = 0; i < n; i++ )
 		{
-			a = 0;
-			b = ParamCount;
+			MODomCnt[ i ] = 0;
+			MOFront[ i ] = ( *getRankPtr( getParamsOrdered( i )) < 1e200 ?
+				0 : -1 );
 		}
-		else
+
+		for( i = 0; i < n; i++ )
 		{
-			a = rnd.getInt( ParamCount );
-			b = a + 1;
-		}
+			uint8_t* const dm = MODomMat + (size_t) i * n;
+			memset( dm, 0, n );
 
-		// Bitmask inversion operation, works as the main "driver" of
-		// optimization process.
+			if( MOFront[ i ] < 0 )
+			{
+				continue;
+			}
 
-		const double r1 = rnd.get();
-		const double r12 = r1 * r1;
-		const int ims = (int) ( r12 * r12 * 48.0 );
-		const ptype imask = ( ims > IntMantBits ? 0 : IntMantMask >> ims );
+			const double* const oi = getObjPtr( getParamsOrdered( i ));
 
-		const int im2s = rnd.getSqrInt( 96 );
-		const ptype imask2 = ( im2s > IntMantBits ? 0 : IntMantMask >> im2s );
+			for( j = 0; j < n; j++ )
+			{
+				if( j != i && MOFront[ j ] >= 0 &&
+					CBiteParetoArchive :: isDominating( oi,
+					getObjPtr( getParamsOrdered( j )), ObjCount ))
+				{
+					dm[ j ] = 1;
+					MODomCnt[ j ]++;
+				}
+			}
+		}
 
-		const int si1 = (int) ( r1 * r12 * ParPopSize );
-		const ptype* const rp1 = ParPop.getParamsOrdered( si1 );
-		int i;
+		// Peel fronts off, via the queue of solutions with zeroed domination
+		// counters.
 
-		for( i = a; i < b; i++ )
+		int qe = 0;
+
+		for( i = 0; i < n; i++ )
 		{
-			Params[ i ] = (( Params[ i ] ^ imask ) +
-				( rp1[ i ] ^ imask2 )) >> 1;
+			if( MOFront[ i ] == 0 && MODomCnt[ i ] == 0 )
+			{
+				MOQueue[ qe ] = i;
+				qe++;
+			}
 		}
 
-		if( rnd.get() < 1.0 - ParamCountI )
+		int qi;
+
+		for( qi = 0; qi < qe; qi++ )
 		{
-			const ptype* const rp2 = ParPop.getParamsOrdered(
-				rnd.getSqrInt( ParPopSize ));
+			const int s = MOQueue[ qi ];
+			const uint8_t* const dm = MODomMat + (size_t) s * n;
 
-			if( rnd.get() < sqrt( ParamCountI ))
+			for( j = 0; j < n; j++ )
 			{
-				if( select( Gen1MoveAsyncSel, rnd ))
+				if( dm[ j ] != 0 )
 				{
-					a = 0;
-					b = ParamCount;
+					MODomCnt[ j ]--;
+
+					if( MODomCnt[ j ] == 0 )
+					{
+						MOFront[ j ] = MOFront[ s ] + 1;
+						MOQueue[ qe ] = j;
+						qe++;
+					}
 				}
 			}
+		}
 
-			// Random move around a random previous solution vector.
+		// Solutions of a front are contiguous in the queue.
 
-			static const double SpanMults[ 4 ] = { 0.5, 1.5, 2.0, 2.5 };
+		int fs = 0;
 
-			const double m = SpanMults[ select( Gen1MoveSpanSel, rnd )];
-			const double m1 = rnd.getTPDF() * m;
-			const double m2 = rnd.getTPDF() * m;
+		while( fs < qe )
+		{
+			const int f = MOFront[ MOQueue[ fs ]];
+			int fe = fs + 1;
 
-			for( i = a; i < b; i++ )
+			while( fe < qe && MOFront[ MOQueue[ fe ]] == f )
 			{
-				Params[ i ] += (ptype) (( rp2[ i ] - Params[ i ]) * m1 );
-				Params[ i ] += (ptype) (( rp2[ i ] - Params[ i ]) * m2 );
+				fe++;
 			}
-		}
-	}
 
-	/**
-	 * The "Differential Evolution"-based solution generator. Note that
-	 * compared to a usual DE, this generator does not use crossover, and
-	 * it uses one, or an average of two best solutions as the base.
-	 */
+			for( i = fs; i < fe; i++ )
+			{
+				const double* const oi =
+					getObjPtr( getParamsOrdered( MOQueue[ i ]));
 
-	void generateSol2( CBiteRnd& rnd )
-	{
-		ptype* const Params = TmpParams;
+				double nd = 1e300;
 
-		const CBitePop& ParPop = *this;
-		const int ParPopSize = ParPop.getCurPopSize();
-		const int ParPopSize1 = ParPopSize - 1;
+				for( j = fs; j < fe; j++ )
+				{
+					if( j != i )
+					{
+						const double d = calcObjDistMO( oi,
+							getObjPtr( getParamsOrdered( MOQueue[ j ])));
 
-		const int si1 = getMinSolIndex( 1, rnd, ParPopSize );
-		const ptype* const rp1 = ParPop.getParamsOrdered( si1 );
-		const ptype* const rp3 = ParPop.getParamsOrdered( ParPopSize1 - si1 );
+						nd = ( d < nd ? d : nd );
+					}
+				}
 
-		const int si2 = 1 + rnd.getInt( ParPopSize1 );
-		const ptype* const rp2 = ParPop.getParamsOrdered( si2 );
+				*getRankPtr( getParamsOrdered( MOQueue[ i ])) =
+					f + 1.0 / ( 2.0 + sqrt( nd ));
+			}
 
-		const int si4 = rnd.getSqrInt( ParPopSize );
-		const ptype* const rp4 = ParPop.getParamsOrdered( si4 );
-		const ptype* const rp5 = ParPop.getParamsOrdered( ParPopSize1 - si4 );
+			fs = fe;
+		}
 
-		// The "step in the right direction" (Differential Evolution
-		// "mutation") operation towards the best (minimal) and away from
-		// the worst (maximal) parameter vector, plus a difference of two
-		// random vectors.
+		// Insertion sort of the population by the new ranks.
 
-		const int Mode = select( Gen2ModeSel, rnd );
-		int i;
+		ptype** const ps = getPopParams();
 
-		if( Mode == 0 )
+		for( i = 1; i < n; i++ )
 		{
-			for( i = 0; i < ParamCount; i++ )
-			{
-				Params[ i ] = rp1[ i ] + ((( rp2[ i ] - rp3[ i ]) +
-					( rp4[ i ] - rp5[ i ])) >> 1 );
-			}
-		}
-		else
-		{
-			const ptype* const rp1b = ParPop.getParamsOrdered(
-				rnd.getSqrInt( ParPopSize ));
+			ptype* const pp = ps[ i ];
+			const double r = *getRankPtr( pp );
+			j = i;
 
-			for( i = 0; i < ParamCount; i++ )
+			while( j > 0 && *getRankPtr( ps[ j - 1 ]) > r )
 			{
-				Params[ i ] = (( rp1[ i ] + rp1b[ i ]) +
-					( rp2[ i ] - rp3[ i ]) + ( rp4[ i ] - rp5[ i ])) >> 1;
+				ps[ j ] = ps[ j - 1 ];
+				j--;
 			}
-		}
-	}
-
-	/**
-	 * An alternative "Differential Evolution"-based solution generator.
-	 */
-
-	void generateSol2b( CBiteRnd& rnd )
-	{
-		ptype* const Params = TmpParams;
-
-		// rand/2/none DE-alike mutation.
-
-		const int si1 = getMinSolIndex( 2, rnd, CurPopSize );
-		const ptype* const rp1 = getParamsOrdered( si1 );
-
-		const int si2 = rnd.getInt( CurPopSize );
-		const ptype* const rp2 = getParamsOrdered( si2 );
-		const ptype* const rp3 = getParamsOrdered( CurPopSize1 - si2 );
 
-		const CBitePop& AltPop = selectAltPop( 0, rnd );
+			ps[ j ] = pp;
+		}
 
-		const int si4 = rnd.getInt( CurPopSize );
-		const ptype* const rp4 = AltPop.getParamsOrdered( si4 );
-		const ptype* const rp5 = AltPop.getParamsOrdered( CurPopSize1 - si4 );
+		commitPopParams();
 
-		const int Mode = select( Gen2bModeSel, rnd );
-		int i;
+		BestCost = *getRankPtr( ps[ 0 ]);
 
-		if( Mode == 0 )
-		{
-			for( i = 0; i < ParamCount; i++ )
-			{
-				Params[ i ] = rp1[ i ] + ((( rp2[ i ] - rp3[ i ]) +
-					( rp4[ i ] - rp5[ i ])) >> 1 );
-			}
-		}
-		else
+		for( i = 0; i < ParamCount; i++ )
 		{
-			const ptype* const rp1b = getParamsOrdered(
-				rnd.getSqrInt( CurPopSize ));
-
-			for( i = 0; i < ParamCount; i++ )
-			{
-				Params[ i ] = ( rp1[ i ] + rp1b[ i ] +
-					( rp2[ i ] - rp3[ i ]) + ( rp4[ i ] - rp5[ i ])) >> 1;
-			}
+			BestValues[ i ] = getRealValue( ps[ 0 ], i );
 		}
 	}
 
 	/**
-	 * "Differential Evolution"-based solution generator, almost an exact
-	 * replica of the CDEOpt optimizer.
+	 * Function accumulates the nearest neighbors of the specified solution
+	 * from the specified population, for the predictRank() function.
+	 *
+	 * @param Pop Population to scan.
+	 * @param Count The number of population vectors to scan.
+	 * @param Params Solution parameters.
+	 * @param[in,out] nd Squared distances of neighbors, sorted ascending.
+	 * @param[in,out] nr Ranks of neighbors.
+	 * @param[in,out] nc The number of neighbors found so far.
 	 */
 
-	void generateSol2c( CBiteRnd& rnd )
+	void findNeighbors( const CBitePop& Pop, const int Count,
+		const ptype* const Params, double* const nd, double* const nr,
+		int& nc ) const
 	{
-		ptype* const Params = TmpParams;
-		zeroParams( Params );
-
-		const int si1 = rnd.getPowInt( 4.0, CurPopSize / 2 );
-		const ptype* const rp1 = getParamsOrdered( si1 );
-
-		const int PairCount = 3;
-		const int pc = 1 + 2 * PairCount;
-		int PopIdx[ pc ];
-		PopIdx[ 0 ] = si1;
-
-		int pp = 1;
-		int i;
 		int j;
 
-		if( CurPopSize1 <= pc )
+		for( j = 0; j < Count; j++ )
 		{
-			while( pp < pc )
+			ptype* const pp = Pop.getParamsOrdered( j );
+			double d = 0.0;
+			int i;
+
+			for( i = 0; i < ParamCount; i++ )
 			{
-				PopIdx[ pp ] = rnd.getInt( CurPopSize );
-				pp++;
+				const double v = (double) ( pp[ i ] - Params[ i ]);
+				d += v * v;
 			}
-		}
-		else
-		{
-			while( pp < pc )
+
+			if( nc == PrescreenNeighCount && d >= nd[ nc - 1 ])
 			{
-				const int sii = rnd.getInt( CurPopSize );
+				continue;
+			}
 
-				for( j = 0; j < pp; j++ )
-				{
-					if( PopIdx[ j ] == sii )
-					{
-						break;
-					}
-				}
+			int k = ( nc < PrescreenNeighCount ? nc++ : nc - 1 );
 
-				if( j == pp )
-				{
-					PopIdx[ pp ] = sii;
-					pp++;
-				}
+			while( k > 0 && nd[ k - 1 ] > d )
+			{
+				nd[ k ] = nd[ k - 1 ];
+				nr[ k ] = nr[ k - 1 ];
+				k--;
 			}
-		}
-
-		const ptype* const rp2 = getParamsOrdered( PopIdx[ 1 ]);
-		const ptype* const rp3 = getParamsOrdered( PopIdx[ 2 ]);
-		const ptype* const rp4 = getParamsOrdered( PopIdx[ 3 ]);
-		const ptype* const rp5 = getParamsOrdered( PopIdx[ 4 ]);
-		const ptype* const rp6 = getParamsOrdered( PopIdx[ 5 ]);
-		const ptype* const rp7 = getParamsOrdered( PopIdx[ 6 ]);
 
-		for( i = 0; i < ParamCount; i++ )
-		{
-			Params[ i ] = ( rp2[ i ] - rp3[ i ]) + ( rp4[ i ] - rp5[ i ]) +
-				( rp6[ i ] - rp7[ i ]);
+			nd[ k ] = d;
+			nr[ k ] = *Pop.getRankPtr( pp );
 		}
+	}
 
-		if( rnd.getBit() && rnd.getBit() )
-		{
-			const int k = rnd.getInt( ParamCount );
-
-			// Produce sparsely-random bit-strings.
-
-			const ptype v1 = rnd.getRaw() & rnd.getRaw() & rnd.getRaw() &
-				rnd.getRaw() & rnd.getRaw() & IntMantMask;
+	/**
+	 * Function predicts rank of the specified solution via inverse squared
+	 * distance weighting of its nearest neighbors in the current and old
+	 * populations.
+	 *
+	 * @param Params Solution parameters.
+	 */
 
-			const ptype v2 = rnd.getRaw() & rnd.getRaw() & rnd.getRaw() &
-				rnd.getRaw() & rnd.getRaw() & IntMantMask;
+	double predictRank( const ptype* const Params ) const
+	{
+		double nd[ PrescreenNeighCount ];
+		double nr[ PrescreenNeighCount ];
+		int nc = 0;
 
-			Params[ k ] += v1 - v2; // Apply in TPDF manner.
-		}
+		findNeighbors( *this, CurPopSize, Params, nd, nr, nc );
+		findNeighbors( OldPops[ 0 ], OldPops[ 0 ].getCurPopPos(), Params,
+			nd, nr, nc );
 
-		const int Mode = select( Gen2cModeSel, rnd );
+		findNeighbors( OldPops[ 1 ], OldPops[ 1 ].getCurPopPos(), Params,
+			nd, nr, nc );
 
-		if( Mode == 0 )
+		if( nd[ 0 ] == 0.0 )
 		{
-			int si2 = si1 + rnd.getBit() * 2 - 1;
-
-			if( si2 < 0 )
-			{
-				si2 = 1;
-			}
+			return( nr[ 0 ]);
+		}
 
-			const ptype* const rp1b = getParamsOrdered( si2 );
+		double s = 0.0;
+		double sw = 0.0;
+		int k;
 
-			for( i = 0; i < ParamCount; i++ )
-			{
-				Params[ i ] = ( rp1[ i ] + rp1b[ i ] + Params[ i ]) >> 1;
-			}
-		}
-		else
+		for( k = 0; k < nc; k++ )
 		{
-			for( i = 0; i < ParamCount; i++ )
-			{
-				Params[ i ] = rp1[ i ] + ( Params[ i ] >> 1 );
-			}
+			const double w = 1.0 / nd[ k ];
+			s += w * nr[ k ];
+			sw += w;
 		}
+
+		return( s / sw );
 	}
 
 	/**
-	 * An alternative "Differential Evolution"-based solution generator that
-	 * uses "OldPop" population.
+	 * Function finds a population's solution equal to the specified one.
+	 * Used for discrete parameters, which are snapped to exact values.
+	 *
+	 * @param Params Solution parameters.
+	 * @return Equal population's solution, NULL if not found.
 	 */
 
-	void generateSol2d( CBiteRnd& rnd )
+	ptype* findPopDup( const ptype* const Params ) const
 	{
-		const CBitePop& OldPop = OldPops[ select( OldPopSel, rnd )];
+		const size_t ps = ParamCount * sizeof( Params[ 0 ]);
+		int j;
 
-		if( OldPop.getCurPopPos() < 3 )
+		for( j = 0; j < CurPopSize; j++ )
 		{
-			generateSol2c( rnd );
-			return;
-		}
-
-		ptype* const Params = TmpParams;
-
-		const ptype* const rp1 = getParamsOrdered(
-			rnd.getSqrInt( CurPopSize ));
-
-		const ptype* const rp2 = getParamsOrdered(
-			rnd.getInt( CurPopSize ));
-
-		const ptype* const rp3 = OldPop.getParamsOrdered(
-			rnd.getInt( OldPop.getCurPopPos() ));
-
-		const int Mode = select( Gen2dModeSel, rnd );
-		int i;
+			ptype* const pp = getParamsOrdered( j );
 
-		if( Mode == 0 )
-		{
-			for( i = 0; i < ParamCount; i++ )
+			if( memcmp( pp, Params, ps ) == 0 )
 			{
-				Params[ i ] = rp1[ i ] + (( rp2[ i ] - rp3[ i ]) >> 1 );
+				return( pp );
 			}
 		}
-		else
-		{
-			const ptype* const rp1b = getParamsOrdered(
-				rnd.getSqrInt( CurPopSize ));
 
-			for( i = 0; i < ParamCount; i++ )
-			{
-				Params[ i ] = (( rp1[ i ] + rp1b[ i ]) +
-					( rp2[ i ] - rp3[ i ])) >> 1;
-			}
-		}
+		return( NULL );
 	}
 
 	/**
-	 * "Centroid mix with DE" solution generator, works well for convex
-	 * functions. For DE operation, uses a better solution and a random
-	 * worse solution.
+	 * Function calls the generateSolSel() function, and records the
+	 * generator's selection and time into the statistics collector.
+	 *
+	 * @param rnd Random number generator.
 	 */
 
-	void generateSol3( CBiteRnd& rnd )
+	void generateSolStat( CBiteRnd& rnd )
 	{
-		ptype* const Params = TmpParams;
+		const int64_t et = GenStats -> getEvalTicks();
+		const int64_t t0 = CBiteGenStats :: getTimestamp();
 
-		const CBitePop& ParPop = selectParPop( 2, rnd );
-		const int ParPopSize = ParPop.getCurPopSize();
+		generateSolSel( rnd );
 
-		const ptype* const rp1 = ParPop.getParamsOrdered(
-			getMinSolIndex( 3, rnd, ParPopSize ));
+		const int64_t t = CBiteGenStats :: getTimestamp() - t0;
+		GenStats -> addSel( SelGen, t - ( GenStats -> getEvalTicks() - et ));
+	}
 
-		const ptype* const rp2 = ParPop.getParamsOrdered(
-			rnd.getSqrIntInv( ParPopSize ));
+	/**
+	 * Function selects a solution generator, and generates a new solution
+	 * into the TmpParams vector. The generator may reset the DoEval variable
+	 * to "false", if the solution was already evaluated.
+	 *
+	 * @param rnd Random number generator.
+	 */
 
-		const int Mode = select( Gen3ModeSel, rnd );
-		int i;
+	void generateSolSel( CBiteRnd& rnd )
+	{
+		const int SelMethod = select( MethodSel, rnd );
 
-		if( Mode == 0 )
+		if( SelMethod == 0 )
 		{
-			for( i = 0; i < ParamCount; i++ )
-			{
-				Params[ i ] = rp1[ i ] + ( rp1[ i ] - rp2[ i ]);
-			}
+			SelGen = genSol2;
+			generateSol2( rnd );
 		}
 		else
+		if( SelMethod == 1 )
 		{
-			static const double CentProb[ 4 ] = { 0.0, 0.25, 0.5, 0.75 };
-			const double p = CentProb[ Mode ];
+			const int SelM1 = select( M1Sel, rnd );
 
-			const ptype* const cp = getCentroid();
+			if( SelM1 == 0 )
+			{
+				const int SelM1A = select( M1ASel, rnd );
+
+				if( SelM1A == 0 )
+				{
+					SelGen = genSol2b;
+					generateSol2b( rnd );
+				}
+				else
+				if( SelM1A == 1 )
+				{
+					SelGen = genSol2c;
+					generateSol2c( rnd );
+				}
+				else
+				{
+					SelGen = genSol2d;
+					generateSol2d( rnd );
+				}
+			}
+			else
+			if( SelM1 == 1 )
+			{
+				const int SelM1B = select( M1BSel, rnd );
+
+				if( SelM1B == 0 )
+				{
+					SelGen = genSol4;
+					generateSol4( rnd );
+				}
+				else
+				if( SelM1B == 1 )
+				{
+					SelGen = genSol5b;
+					generateSol5b( rnd );
+				}
+				else
+				if( SelM1B == 2 )
+				{
+					SelGen = genSol5c;
+					generateSol5c( rnd );
+				}
+				else
+				{
+					SelGen = genSol13;
+					generateSol13( rnd );
+				}
+			}
+			else
+			if( SelM1 == 2 )
+			{
+				const int SelM1C = select( M1CSel, rnd );
+
+				if( SelM1C == 0 )
+				{
+					SelGen = genSol5;
+					generateSol5( rnd );
+				}
+				else
+				if( SelM1C == 1 )
+				{
+					SelGen = genSol10;
+					generateSol10( rnd );
+				}
+				else
+				{
+					SelGen = genSol11;
+					generateSol11( rnd );
+				}
+			}
+			else
+			{
+				SelGen = genSol6;
+				generateSol6( rnd );
+			}
+		}
+		else
+		if( SelMethod == 2 )
+		{
+			if( select( M2Sel, rnd ))
+			{
+				SelGen = genSol1;
+				generateSol1( rnd );
+			}
+			else
+			{
+				const int SelM2B = select( M2BSel, rnd );
+
+				if( SelM2B == 0 )
+				{
+					SelGen = genSol3;
+					generateSol3( rnd );
+				}
+				else
+				if( SelM2B == 1 )
+				{
+					SelGen = genSol7;
+					generateSol7( rnd );
+				}
+				else
+				if( SelM2B == 2 )
+				{
+					SelGen = genSol8;
+					generateSol8( rnd );
+				}
+				else
+				if( SelM2B == 3 )
+				{
+					SelGen = genSol9;
+					generateSol9( rnd );
+				}
+				else
+				{
+					SelGen = genSol12;
+					generateSol12( rnd );
+				}
+			}
+		}
+		else
+		if( ObjCount > 1 )
+		{
+			// Parallel optimizers are single-objective.
+
+			SelGen = genSol1;
+			generateSol1( rnd );
+		}
+		else
+		{
+			SelGen = genSolPar;
+			generateSolPar( rnd );
+		}
+	}
+
+	/**
+	 * Function updates an appropriate parallel population.
+	 *
+	 * @param UpdCost Cost of the new solution.
+	 * @param UpdParams New parameter values.
+	 */
+
+	void updateParPop( const double UpdCost, const ptype* const UpdParams )
+	{
+		const int p = getMinDistParPop( UpdCost, UpdParams );
+
+		if( p >= 0 )
+		{
+			ParPops[ p ] -> updatePop( UpdCost, UpdParams, true, 0 );
+		}
+	}
+
+	/**
+	 * Function selects a parallel population to use for solution generation.
+	 * With certain probability, *this object's own population will be
+	 * returned instead of parallel population.
+	 *
+	 * @param gi Solution generator index (0-7).
+	 * @param rnd PRNG object.
+	 */
+
+	CBitePop& selectParPop( const int gi, CBiteRnd& rnd )
+	{
+		if( select( ParPopPSel[ gi ], rnd ))
+		{
+			return( *ParPops[ rnd.getInt( ParPopCount )]);
+		}
+
+		return( *this );
+	}
+
+	/**
+	 * Function selects an alternative, parallel optimizer's, population, to
+	 * use in some solution generators.
+	 *
+	 * @param gi Solution generator index (0-3).
+	 * @param rnd PRNG object.
+	 */
+
+	CBitePop& selectAltPop( const int gi, CBiteRnd& rnd )
+	{
+		if( select( AltPopPSel, rnd ))
+		{
+			if( select( AltPopSel[ gi ], rnd ))
+			{
+				if( ParOptPop.getCurPopPos() >= CurPopSize )
+				{
+					return( ParOptPop );
+				}
+			}
+			else
+			{
+				if( ParOpt2Pop.getCurPopPos() >= CurPopSize )
+				{
+					return( ParOpt2Pop );
+				}
+			}
+		}
+
+		return( *this );
+	}
+
+	/**
+	 * Function returns a dynamically-selected minimal population index, used
+	 * in some solution generation methods.
+	 *
+	 * @param gi Solution generator index (0-3).
+	 * @param rnd PRNG object.
+	 * @param ps Population size.
+	 */
+
+	int getMinSolIndex( const int gi, CBiteRnd& rnd, const int ps )
+	{
+		// Equivalent to calcMinSolIndex() of a getRaw() value, via
+		// threshold tables.
+
+		const int pi = select( MinSolPwrSel[ gi ], rnd );
+		const uint64_t u = rnd.getRaw() >> ( 64 - 53 );
+		const int mi = select( MinSolMulSel[ gi ], rnd );
+
+		if( mi == 0 )
+		{
+			return( 0 );
+		}
+
+		const uint64_t* const Thr = getMinSolThr( ps ) +
+			( pi * 3 + mi - 1 ) * MinSolThrLen;
+
+		int c = 0;
+
+		while( c < MinSolThrLen && u >= Thr[ c ])
+		{
+			c++;
+		}
+
+		if( c < MinSolThrLen )
+		{
+			return( c );
+		}
+
+		return( calcMinSolIndex( u, ps, pi, mi ));
+	}
+
+	/**
+	 * Function calculates a minimal population index, as selected by the
+	 * getMinSolIndex() function.
+	 *
+	 * @param u 53-bit uniform random value.
+	 * @param ps Population size.
+	 * @param pi Power factor index (0-3).
+	 * @param mi Multiplier index (0-3).
+	 */
+
+	static int calcMinSolIndex( const uint64_t u, const int ps, const int pi,
+		const int mi )
+	{
+		const double r = ps * CBiteRnd :: calcPow( u * 0x1p-53,
+			ps * getMinSolPwr( pi ));
+
+		return( (int) ( r * getMinSolMul( mi )));
+	}
+
+	/**
+	 * @return Power factor of the getMinSolIndex() function.
+	 * @param pi Power factor index (0-3).
+	 */
+
+	static double getMinSolPwr( const int pi )
+	{
+		static const double pp[ 4 ] = { 0.05, 0.125, 0.25, 0.5 };
+
+		return( pp[ pi ]);
+	}
+
+	/**
+	 * @return Multiplier of the getMinSolIndex() function.
+	 * @param mi Multiplier index (0-3).
+	 */
+
+	static double getMinSolMul( const int mi )
+	{
+		static const double rm[ 4 ] = { 0.0, 0.125, 0.25, 0.5 };
+
+		return( rm[ mi ]);
+	}
+
+	/**
+	 * Function returns the getMinSolIndex() function's threshold tables for
+	 * the specified population size, and calculates them on first use.
+	 * There are 12 tables of MinSolThrLen elements, for power factor and
+	 * non-zero multiplier index pairs. Threshold "k" is the least 53-bit
+	 * random value that produces an index above "k", as in the
+	 * CBiteSelBase::calcPowThr() function; unused thresholds are set to
+	 * UINT64_MAX.
+	 *
+	 * @param ps Population size.
+	 */
+
+	const uint64_t* getMinSolThr( const int ps )
+	{
+		if( ps >= MinSolThrsLen )
+		{
+			const int NewLen = ps + 1;
+			uint64_t** const NewThrs = new uint64_t*[ NewLen ];
+			int i;
+
+			for( i = 0; i < NewLen; i++ )
+			{
+				NewThrs[ i ] = ( i < MinSolThrsLen ? MinSolThrs[ i ] : NULL );
+			}
+
+			delete[] MinSolThrs;
+			MinSolThrs = NewThrs;
+			MinSolThrsLen = NewLen;
+		}
+
+		if( MinSolThrs[ ps ] != NULL )
+		{
+			return( MinSolThrs[ ps ]);
+		}
+
+		uint64_t* const Thrs = new uint64_t[ 12 * MinSolThrLen ];
+		const int64_t um = ( (int64_t) 1 << 53 ) - 1;
+		int pi, mi, k;
+
+		for( pi = 0; pi < 4; pi++ )
+		{
+			for( mi = 1; mi < 4; mi++ )
+			{
+				uint64_t* const Thr = Thrs + ( pi * 3 + mi - 1 ) *
+					MinSolThrLen;
+
+				const int n = calcMinSolIndex( um, ps, pi, mi );
+				const double e = ps * getMinSolPwr( pi );
+				const double rs = ps * getMinSolMul( mi );
+
+				for( k = 1; k <= MinSolThrLen; k++ )
+				{
+					if( k > n )
+					{
+						Thr[ k - 1 ] = UINT64_MAX;
+						continue;
+					}
+
+					// Bracket the threshold around its estimate, and refine
+					// it via binary search. f( 0 ) = 0 < k <= f( um ).
+
+					const int64_t g = (int64_t) ( pow( k / rs, 1.0 / e ) *
+						0x1p53 );
+
+					int64_t lo = ( g - 4 < 0 ? 0 : g - 4 );
+					int64_t hi = ( g + 4 > um ? um : g + 4 );
+					int64_t d = 8;
+
+					while( lo > 0 && calcMinSolIndex( lo, ps, pi, mi ) >= k )
+					{
+						lo = ( lo - d < 0 ? 0 : lo - d );
+						d *= 2;
+					}
+
+					d = 8;
+
+					while( calcMinSolIndex( hi, ps, pi, mi ) < k )
+					{
+						hi = ( hi + d > um ? um : hi + d );
+						d *= 2;
+					}
+
+					while( hi - lo > 1 )
+					{
+						const int64_t mid = ( lo + hi ) >> 1;
+
+						if( calcMinSolIndex( mid, ps, pi, mi ) >= k )
+						{
+							hi = mid;
+						}
+						else
+						{
+							lo = mid;
+						}
+					}
+
+					Thr[ k - 1 ] = (uint64_t) hi;
+				}
+			}
+		}
+
+		MinSolThrs[ ps ] = Thrs;
+
+		return( Thrs );
+	}
+
+	/**
+	 * The original "bitmask inversion with random move" solution generator.
+	 * Most of the time adjusts only a single parameter of a better solution,
+	 * yet manages to produce excellent "reference points".
+	 */
+
+	void generateSol1( CBiteRnd& rnd )
+	{
+		ptype* const Params = TmpParams;
+
+		const CBitePop& ParPop = selectParPop( 0, rnd );
+		const int ParPopSize = ParPop.getCurPopSize();
+
+		const ptype* const rp0 = ParPop.getParamsOrdered(
+			getMinSolIndex( 0, rnd, ParPopSize ));
+
+		copyParams( Params, rp0 );
+		DeltaParent = rp0;
+
+		// Select a single random parameter or all parameters for further
+		// operations.
+
+		int a;
+		int b;
+		bool DoAllp = false;
+
+		if( rnd.get() < 1.8 * ParamCountI )
+		{
+			if( select( Gen1AllpSel, rnd ))
+			{
+				DoAllp = true;
+			}
+		}
+
+		if( DoAllp )
+		{
+			a = 0;
+			b = ParamCount;
+		}
+		else
+		{
+			a = rnd.getInt( ParamCount );
+			b = a + 1;
+		}
+
+		// Bitmask inversion operation, works as the main "driver" of
+		// optimization process.
+
+		const double r1 = rnd.get();
+		const double r12 = r1 * r1;
+		const int ims = (int) ( r12 * r12 * 48.0 );
+		const ptype imask = ( ims > IntMantBits ? 0 : IntMantMask >> ims );
+
+		const int im2s = rnd.getSqrInt( 96 );
+		const ptype imask2 = ( im2s > IntMantBits ? 0 : IntMantMask >> im2s );
+
+		const int si1 = (int) ( r1 * r12 * ParPopSize );
+		const ptype* const rp1 = ParPop.getParamsOrdered( si1 );
+		int i;
+
+		for( i = a; i < b; i++ )
+		{
+			Params[ i ] = (( Params[ i ] ^ imask ) +
+				( rp1[ i ] ^ imask2 )) >> 1;
+		}
+
+		if( rnd.get() < 1.0 - ParamCountI )
+		{
+			const ptype* const rp2 = ParPop.getParamsOrdered(
+				rnd.getSqrInt( ParPopSize ));
+
+			if( rnd.get() < sqrt( ParamCountI ))
+			{
+				if( select( Gen1MoveAsyncSel, rnd ))
+				{
+					a = 0;
+					b = ParamCount;
+				}
+			}
+
+			// Random move around a random previous solution vector.
+
+			static const double SpanMults[ 4 ] = { 0.5, 1.5, 2.0, 2.5 };
+
+			const double m = SpanMults[ select( Gen1MoveSpanSel, rnd )];
+			const double m1 = rnd.getTPDF() * m;
+			const double m2 = rnd.getTPDF() * m;
+
+			for( i = a; i < b; i++ )
+			{
+				Params[ i ] += (ptype) (( rp2[ i ] - Params[ i ]) * m1 );
+				Params[ i ] += (ptype) (( rp2[ i ] - Params[ i ]) * m2 );
+			}
+		}
+	}
+
+	/**
+	 * The "Differential Evolution"-based solution generator. Note that
+	 * compared to a usual DE, this generator does not use crossover, and
+	 * it uses one, or an average of two best solutions as the base.
+	 */
+
+	void generateSol2( CBiteRnd& rnd )
+	{
+		ptype* const Params = TmpParams;
+
+		const CBitePop& ParPop = *this;
+		const int ParPopSize = ParPop.getCurPopSize();
+		const int ParPopSize1 = ParPopSize - 1;
+
+		const int si1 = getMinSolIndex( 1, rnd, ParPopSize );
+		const ptype* const rp1 = ParPop.getParamsOrdered( si1 );
+		const ptype* const rp3 = ParPop.getParamsOrdered( ParPopSize1 - si1 );
+
+		const int si2 = 1 + rnd.getInt( ParPopSize1 );
+		const ptype* const rp2 = ParPop.getParamsOrdered( si2 );
+
+		const int si4 = rnd.getSqrInt( ParPopSize );
+		const ptype* const rp4 = ParPop.getParamsOrdered( si4 );
+		const ptype* const rp5 = ParPop.getParamsOrdered( ParPopSize1 - si4 );
+
+		// The "step in the right direction" (Differential Evolution
+		// "mutation") operation towards the best (minimal) and away from
+		// the worst (maximal) parameter vector, plus a difference of two
+		// random vectors.
+
+		const int Mode = select( Gen2ModeSel, rnd );
+		int i;
+
+		if( Mode == 0 )
+		{
+			for( i = 0; i < ParamCount; i++ )
+			{
+				Params[ i ] = rp1[ i ] + ((( rp2[ i ] - rp3[ i ]) +
+					( rp4[ i ] - rp5[ i ])) >> 1 );
+			}
+		}
+		else
+		{
+			const ptype* const rp1b = ParPop.getParamsOrdered(
+				rnd.getSqrInt( ParPopSize ));
+
+			for( i = 0; i < ParamCount; i++ )
+			{
+				Params[ i ] = (( rp1[ i ] + rp1b[ i ]) +
+					( rp2[ i ] - rp3[ i ]) + ( rp4[ i ] - rp5[ i ])) >> 1;
+			}
+		}
+	}
+
+	/**
+	 * An alternative "Differential Evolution"-based solution generator.
+	 */
+
+	void generateSol2b( CBiteRnd& rnd )
+	{
+		ptype* const Params = TmpParams;
+
+		// rand/2/none DE-alike mutation.
+
+		const int si1 = getMinSolIndex( 2, rnd, CurPopSize );
+		const ptype* const rp1 = getParamsOrdered( si1 );
+
+		const int si2 = rnd.getInt( CurPopSize );
+		const ptype* const rp2 = getParamsOrdered( si2 );
+		const ptype* const rp3 = getParamsOrdered( CurPopSize1 - si2 );
+
+		const CBitePop& AltPop = selectAltPop( 0, rnd );
+
+		const int si4 = rnd.getInt( CurPopSize );
+		const ptype* const rp4 = AltPop.getParamsOrdered( si4 );
+		const ptype* const rp5 = AltPop.getParamsOrdered( CurPopSize1 - si4 );
+
+		const int Mode = select( Gen2bModeSel, rnd );
+		int i;
+
+		if( Mode == 0 )
+		{
+			for( i = 0; i < ParamCount; i++ )
+			{
+				Params[ i ] = rp1[ i ] + ((( rp2[ i ] - rp3[ i ]) +
+					( rp4[ i ] - rp5[ i ])) >> 1 );
+			}
+		}
+		else
+		{
+			const ptype* const rp1b = getParamsOrdered(
+				rnd.getSqrInt( CurPopSize ));
+
+			for( i = 0; i < ParamCount; i++ )
+			{
+				Params[ i ] = ( rp1[ i ] + rp1b[ i ] +
+					( rp2[ i ] - rp3[ i ]) + ( rp4[ i ] - rp5[ i ])) >> 1;
+			}
+		}
+	}
+
+	/**
+	 * "Differential Evolution"-based solution generator, almost an exact
+	 * replica of the CDEOpt optimizer.
+	 */
+
+	void generateSol2c( CBiteRnd& rnd )
+	{
+		ptype* const Params = TmpParams;
+		zeroParams( Params );
+
+		const int si1 = rnd.getPowInt( 4.0, CurPopSize / 2 );
+		const ptype* const rp1 = getParamsOrdered( si1 );
+
+		const int PairCount = 3;
+		const int pc = 1 + 2 * PairCount;
+		int PopIdx[ pc ];
+		PopIdx[ 0 ] = si1;
+
+		int pp = 1;
+		int i;
+		int j;
+
+		if( CurPopSize1 <= pc )
+		{
+			while( pp < pc )
+			{
+				PopIdx[ pp ] = rnd.getInt( CurPopSize );
+				pp++;
+			}
+		}
+		else
+		{
+			while( pp < pc )
+			{
+				const int sii = rnd.getInt( CurPopSize );
+
+				for( j = 0; j < pp; j++ )
+				{
+					if( PopIdx[ j ] == sii )
+					{
+						break;
+					}
+				}
+
+				if( j == pp )
+				{
+					PopIdx[ pp ] = sii;
+					pp++;
+				}
+			}
+		}
+
+		const ptype* const rp2 = getParamsOrdered( PopIdx[ 1 ]);
+		const ptype* const rp3 = getParamsOrdered( PopIdx[ 2 ]);
+		const ptype* const rp4 = getParamsOrdered( PopIdx[ 3 ]);
+		const ptype* const rp5 = getParamsOrdered( PopIdx[ 4 ]);
+		const ptype* const rp6 = getParamsOrdered( PopIdx[ 5 ]);
+		const ptype* const rp7 = getParamsOrdered( PopIdx[ 6 ]);
+
+		for( i = 0; i < ParamCount; i++ )
+		{
+			Params[ i ] = ( rp2[ i ] - rp3[ i ]) + ( rp4[ i ] - rp5[ i ]) +
+				( rp6[ i ] - rp7[ i ]);
+		}
+
+		if( rnd.getBit() && rnd.getBit() )
+		{
+			const int k = rnd.getInt( ParamCount );
+
+			// Produce sparsely-random bit-strings.
+
+			const ptype v1 = rnd.getRaw() & rnd.getRaw() & rnd.getRaw() &
+				rnd.getRaw() & rnd.getRaw() & IntMantMask;
+
+			const ptype v2 = rnd.getRaw() & rnd.getRaw() & rnd.getRaw() &
+				rnd.getRaw() & rnd.getRaw() & IntMantMask;
+
+			Params[ k ] += v1 - v2; // Apply in TPDF manner.
+		}
+
+		const int Mode = select( Gen2cModeSel, rnd );
+
+		if( Mode == 0 )
+		{
+			int si2 = si1 + rnd.getBit() * 2 - 1;
+
+			if( si2 < 0 )
+			{
+				si2 = 1;
+			}
+
+			const ptype* const rp1b = getParamsOrdered( si2 );
+
+			for( i = 0; i < ParamCount; i++ )
+			{
+				Params[ i ] = ( rp1[ i ] + rp1b[ i ] + Params[ i ]) >> 1;
+			}
+		}
+		else
+		{
+			for( i = 0; i < ParamCount; i++ )
+			{
+				Params[ i ] = rp1[ i ] + ( Params[ i ] >> 1 );
+			}
+		}
+	}
+
+	/**
+	 * An alternative "Differential Evolution"-based solution generator that
+	 * uses "OldPop" population.
+	 */
+
+	void generateSol2d( CBiteRnd& rnd )
+	{
+		const CBitePop& OldPop = OldPops[ select( OldPopSel, rnd )];
+
+		if( OldPop.getCurPopPos() < 3 )
+		{
+			generateSol2c( rnd );
+			return;
+		}
+
+		ptype* const Params = TmpParams;
+
+		const ptype* const rp1 = getParamsOrdered(
+			rnd.getSqrInt( CurPopSize ));
+
+		const ptype* const rp2 = getParamsOrdered(
+			rnd.getInt( CurPopSize ));
+
+		const ptype* const rp3 = OldPop.getParamsOrdered(
+			rnd.getInt( OldPop.getCurPopPos() ));
+
+		const int Mode = select( Gen2dModeSel, rnd );
+		int i;
+
+		if( Mode == 0 )
+		{
+			for( i = 0; i < ParamCount; i++ )
+			{
+				Params[ i ] = rp1[ i ] + (( rp2[ i ] - rp3[ i ]) >> 1 );
+			}
+		}
+		else
+		{
+			const ptype* const rp1b = getParamsOrdered(
+				rnd.getSqrInt( CurPopSize ));
+
+			for( i = 0; i < ParamCount; i++ )
+			{
+				Params[ i ] = (( rp1[ i ] + rp1b[ i ]) +
+					( rp2[ i ] - rp3[ i ])) >> 1;
+			}
+		}
+	}
+
+	/**
+	 * "Centroid mix with DE" solution generator, works well for convex
+	 * functions. For DE operation, uses a better solution and a random
+	 * worse solution.
+	 */
+
+	void generateSol3( CBiteRnd& rnd )
+	{
+		ptype* const Params = TmpParams;
+
+		const CBitePop& ParPop = selectParPop( 2, rnd );
+		const int ParPopSize = ParPop.getCurPopSize();
+
+		const ptype* const rp1 = ParPop.getParamsOrdered(
+			getMinSolIndex( 3, rnd, ParPopSize ));
+
+		const ptype* const rp2 = ParPop.getParamsOrdered(
+			rnd.getSqrIntInv( ParPopSize ));
+
+		const int Mode = select( Gen3ModeSel, rnd );
+		int i;
+
+		if( Mode == 0 )
+		{
+			for( i = 0; i < ParamCount; i++ )
+			{
+				Params[ i ] = rp1[ i ] + ( rp1[ i ] - rp2[ i ]);
+			}
+		}
+		else
+		{
+			static const double CentProb[ 4 ] = { 0.0, 0.25, 0.5, 0.75 };
+			const double p = CentProb[ Mode ];
+
+			const ptype* const cp = getCentroid();
+
+			for( i = 0; i < ParamCount; i++ )
+			{
+				Params[ i ] = ( rnd.get() < p ? cp[ i ] :
+					rp1[ i ] + ( rp1[ i ] - rp2[ i ]));
+			}
+		}
+	}
+
+	/**
+	 * "Entropy bit mixing"-based solution generator. Performs crossing-over
+	 * of an odd number (this is important) of random solutions via XOR
+	 * operation. Slightly less effective than the DE-based mixing, but makes
+	 * the optimization method more diverse overall.
+	 */
+
+	void generateSol4( CBiteRnd& rnd )
+	{
+		ptype* const Params = TmpParams;
+
+		const CBitePop* UsePops[ 2 ];
+		UsePops[ 0 ] = &selectAltPop( 1, rnd );
+		UsePops[ 1 ] = &selectParPop( 3, rnd );
+
+		int UseSize[ 2 ];
+		UseSize[ 0 ] = CurPopSize;
+		UseSize[ 1 ] = UsePops[ 1 ] -> getCurPopSize();
+
+		const int km = 3 + ( select( Gen4MixFacSel, rnd ) << 1 );
+
+		int p = rnd.getBit();
+		const ptype* rp1 = UsePops[ p ] -> getParamsOrdered(
+			rnd.getSqrInt( UseSize[ p ]));
+
+		copyParams( Params, rp1 );
+		int k;
+
+		for( k = 1; k < km; k++ )
+		{
+			p = rnd.getBit();
+			rp1 = UsePops[ p ] -> getParamsOrdered(
+				rnd.getSqrInt( UseSize[ p ]));
+
+			int i;
+
+			for( i = 0; i < ParamCount; i++ )
+			{
+				Params[ i ] ^= rp1[ i ];
+			}
+		}
+
+		// Simple XOR randomize.
+
+		int b = rnd.getSqrInt( 54 );
+		b = ( b > IntMantBits ? IntMantBits : b );
+
+		Params[ rnd.getInt( ParamCount )] ^=
+			( rnd.getRaw() & IntMantMask ) >> b;
+	}
+
+	/**
+	 * A novel "Randomized bit crossing-over" candidate solution generation
+	 * method. Effective, but on its own cannot stand coordinate system
+	 * offsets, converges slowly. Completely mixes bits of two
+	 * randomly-selected solutions, plus changes 1 random bit.
+	 *
+	 * This method is similar to a biological DNA crossing-over, but on a
+	 * single-bit scale.
+	 */
+
+	void generateSol5( CBiteRnd& rnd )
+	{
+		ptype* const Params = TmpParams;
+
+		const CBitePop& ParPop = selectParPop( 4, rnd );
+
+		const ptype* const CrossParams1 = ParPop.getParamsOrdered(
+			rnd.getSqrInt( ParPop.getCurPopSize() ));
+
+		const CBitePop& AltPop = selectAltPop( 2, rnd );
+
+		const ptype* const CrossParams2 = AltPop.getParamsOrdered(
+			rnd.getSqrInt( CurPopSize ));
+
+		int i;
+
+		for( i = 0; i < ParamCount; i++ )
+		{
+			// Produce a random bit-mixing mask.
+
+			const ptype crpl = rnd.getRaw() & IntMantMask;
+
+			Params[ i ] = ( CrossParams1[ i ] & crpl ) |
+				( CrossParams2[ i ] & ~crpl );
+
+			// Randomize a single bit, in TPDF manner.
+
+			const int b = rnd.getInt( IntMantBits );
+
+			Params[ i ] += ( (ptype) rnd.getBit() << b ) -
+				( (ptype) rnd.getBit() << b );
+		}
+	}
+
+	/**
+	 * "Randomized parameter cross-over" solution generator. Similar to the
+	 * "randomized bit cross-over", but works with the whole parameter values.
+	 */
+
+	void generateSol5b( CBiteRnd& rnd )
+	{
+		ptype* const Params = TmpParams;
+		const ptype* CrossParams[ 4 ];
+
+		const CBitePop& ParPop = selectParPop( 5, rnd );
+		const int ParPopSize = ParPop.getCurPopSize();
+
+		CrossParams[ 0 ] = ParPop.getParamsOrdered(
+			rnd.getSqrInt( ParPopSize ));
+
+		const CBitePop& AltPop = selectAltPop( 3, rnd );
+
+		if( rnd.getBit() )
+		{
+			CrossParams[ 1 ] = AltPop.getParamsOrdered(
+				rnd.getSqrIntInv( CurPopSize ));
+		}
+		else
+		{
+			CrossParams[ 1 ] = AltPop.getParamsOrdered(
+				rnd.getSqrInt( CurPopSize ));
+		}
+
+		const int Mode = select( Gen5bModeSel, rnd );
+		int i;
+
+		if( Mode == 0 )
+		{
+			for( i = 0; i < ParamCount; i++ )
+			{
+				Params[ i ] = CrossParams[ rnd.getBit() ][ i ];
+			}
+		}
+		else
+		{
+			CrossParams[ 2 ] = ParPop.getParamsOrdered(
+				rnd.getSqrInt( ParPopSize ));
+
+			CrossParams[ 3 ] = AltPop.getParamsOrdered(
+				rnd.getSqrInt( CurPopSize ));
+
+			for( i = 0; i < ParamCount; i++ )
+			{
+				Params[ i ] = CrossParams[ rnd.getBit() << 1 |
+					rnd.getBit() ][ i ];
+			}
+		}
+
+		// Simple XOR randomize.
+
+		int b = rnd.getSqrInt( 54 );
+		b = ( b > IntMantBits ? IntMantBits : b );
+
+		Params[ rnd.getInt( ParamCount )] ^=
+			( rnd.getRaw() & IntMantMask ) >> b;
+	}
+
+	/**
+	 * "Genetic crossing-over" candidate solution generation method.
+	 * Completely mixes parameter parts of two randomly-selected solutions,
+	 * at random crossover point, plus adds a random step. This method is
+	 * similar to generator 5.
+	 */
+
+	void generateSol5c( CBiteRnd& rnd )
+	{
+		ptype* const Params = TmpParams;
+
+		const CBitePop& ParPop = selectParPop( 6, rnd );
+		const int ParPopSize = ParPop.getCurPopSize();
+
+		const ptype* const rp1 = ParPop.getParamsOrdered(
+			rnd.getSqrInt( ParPopSize ));
+
+		const ptype* const rp2 = ParPop.getParamsOrdered(
+			rnd.getSqrInt( ParPopSize ));
+
+		const ptype* const rp3 = ParPop.getParamsOrdered(
+			rnd.getSqrIntInv( ParPopSize ));
+
+		int i;
+
+		for( i = 0; i < ParamCount; i++ )
+		{
+			// Produce a bit-mixing mask.
+
+			ptype crm = ( (ptype) 1 << rnd.getInt( IntMantBits )) - 1;
+
+			if( rnd.getBit() )
+			{
+				crm ^= IntMantMask;
+			}
+
+			Params[ i ] = ( rp1[ i ] & crm ) | ( rp2[ i ] & ~crm );
+
+			// Randomize, depending on difference between better and worse
+			// parameter values.
+
+			Params[ i ] += (ptype) (( rp1[ i ] - rp3[ i ]) * rnd.getTPDF() );
+		}
+	}
+
+	/**
+	 * A short-cut solution generator. Parameter value short-cuts: they
+	 * considerably reduce convergence time for some functions while not
+	 * severely impacting performance for other functions.
+	 *
+	 * Can use variation with randomization between two values, and a slight
+	 * move towards real 0.
+	 */
+
+	void generateSol6( CBiteRnd& rnd )
+	{
+		ptype* const Params = TmpParams;
+
+		const double r = rnd.getPow( 4.0 );
+		const int si = (int) ( r * CurPopSize );
+
+		double v[ 2 ];
+		v[ 0 ] = getRealValue( getParamsOrdered( si ),
+			rnd.getInt( ParamCount ));
+
+		if( rnd.getBit() )
+		{
+			v[ 1 ] = getRealValue( getParamsOrdered( si ),
+				rnd.getInt( ParamCount ));
+		}
+		else
+		{
+			v[ 1 ] = v[ 0 ];
+		}
+
+		const double m = 1.0 - r * r;
+		v[ 0 ] *= m; // Move towards real 0, useful for some functions.
+		v[ 1 ] *= m;
+
+		int i;
+
+		for( i = 0; i < ParamCount; i++ )
+		{
+			Params[ i ] = (ptype) (( v[ rnd.getBit() ] - MinValues[ i ]) *
+				DiffValuesI[ i ]);
+		}
+	}
+
+	/**
+	 * A solution generator that randomly combines solutions from the main
+	 * and "old" populations. Conceptually, it can be called a
+	 * weighted-random crossover that combines solutions from diverse
+	 * sources.
+	 */
+
+	void generateSol7( CBiteRnd& rnd )
+	{
+		ptype* const Params = TmpParams;
+
+		const CBitePop& OldPop = OldPops[ 1 ];
+		const int OldPopPos = OldPop.getCurPopPos();
+
+		static const double p[ 4 ] = { 1.5, 1.75, 2.0, 2.25 };
+		const double pwr = p[ select( Gen7PowFacSel, rnd )];
+		int i;
+
+		if( OldPopPos < 3 )
+		{
+			for( i = 0; i < ParamCount; i++ )
+			{
+				Params[ i ] = getParamsOrdered(
+					rnd.getPowInt( pwr, CurPopSize ))[ i ];
+			}
+		}
+		else
+		{
+			for( i = 0; i < ParamCount; i++ )
+			{
+				if( rnd.getBit() && rnd.getBit() )
+				{
+					Params[ i ] = OldPop.getParamsOrdered(
+						rnd.getPowInt( pwr, OldPopPos ))[ i ];
+				}
+				else
+				{
+					Params[ i ] = getParamsOrdered(
+						rnd.getPowInt( pwr, CurPopSize ))[ i ];
+				}
+			}
+		}
+	}
+
+	/**
+	 * Solution generator that is DE-alike in its base. It calculates a
+	 * centroid of a number of best solutions, and then applies "mutation"
+	 * operation between the centroid and the solutions, using a random
+	 * multiplier. This generator is similar to the "move" operation of
+	 * generator 1.
+	 */
+
+	void generateSol8( CBiteRnd& rnd )
+	{
+		ptype* const Params = TmpParams;
+
+		const int Mode = select( Gen8ModeSel, rnd );
+		const int NumSols = 5 + select( Gen8NumSel, rnd );
+		const ptype* rp[ 8 ];
+
+		// Calculate centroid of a number of selected solutions.
+
+		const ptype* rp0 = getParamsOrdered( rnd.getSqrInt( CurPopSize ));
+		rp[ 0 ] = rp0;
+		copyParams( Params, rp0 );
+
+		int j;
+		int i;
+
+		for( j = 1; j < NumSols; j++ )
+		{
+			rp0 = getParamsOrdered( rnd.getSqrInt( CurPopSize ));
+			rp[ j ] = rp0;
+
+			for( i = 0; i < ParamCount; i++ )
+			{
+				Params[ i ] += rp0[ i ];
+			}
+		}
+
+		const double m = 1.0 / NumSols;
+
+		for( i = 0; i < ParamCount; i++ )
+		{
+			NewValues[ i ] = Params[ i ] * m; // Centroid.
+			Params[ i ] = (ptype) NewValues[ i ];
+		}
+
+		// Apply "move" operations in one of two modes.
+
+		if( Mode == 0 )
+		{
+			static const double Spans[ 4 ] = { 1.5, 2.5, 3.5, 4.5 };
+			const double gm = Spans[ select( Gen8SpanSel[ Mode ], rnd )] *
+				sqrt( m );
+
+			for( j = 0; j < NumSols; j++ )
+			{
+				const double r = rnd.getGaussian() * gm;
+				rp0 = rp[ j ];
+
+				for( i = 0; i < ParamCount; i++ )
+				{
+					Params[ i ] += (ptype) (( NewValues[ i ] - rp0[ i ]) * r );
+				}
+			}
+		}
+		else
+		{
+			static const double Spans[ 4 ] = { 0.5, 1.5, 2.5, 3.5 };
+			const double gm = Spans[ select( Gen8SpanSel[ Mode ], rnd )];
+
+			for( j = 0; j < NumSols; j++ )
+			{
+				const double r = rnd.getGaussian() * gm;
+				rp0 = rp[ j ];
+
+				for( i = 0; i < ParamCount; i++ )
+				{
+					Params[ i ] += (ptype) (( Params[ i ] - rp0[ i ]) * r );
+				}
+			}
+		}
+	}
+
+	/**
+	 * A "water drain" solution generator: makes a fixed-multiplier step from
+	 * a better random solution 1 towards or away from worse random solution
+	 * 2. Moderately efficient on its own.
+	 */
+
+	void generateSol9( CBiteRnd& rnd )
+	{
+		ptype* const Params = TmpParams;
+
+		const ptype* const rp1 = getParamsOrdered(
+			rnd.getInt( CurPopSize ));
+
+		const ptype* const rp2 = getParamsOrdered(
+			rnd.getSqrIntInv( CurPopSize ));
+
+		int i;
+
+		// Such overall sign inversion seems unuseful, but has benefits in
+		// practice.
+
+		if( rnd.getBit() )
+		{
+			for( i = 0; i < ParamCount; i++ )
+			{
+				Params[ i ] = rp1[ i ] - (( rp2[ i ] - rp1[ i ]) >> 1 ) *
+					( 1 - 2 * rnd.getBit() );
+			}
+		}
+		else
+		{
+			for( i = 0; i < ParamCount; i++ )
+			{
+				Params[ i ] = rp1[ i ] + (( rp2[ i ] - rp1[ i ]) >> 1 ) *
+					( 1 - 2 * rnd.getBit() );
+			}
+		}
+	}
+
+	/**
+	 * Solution generator based on SpherOpt's converging hyper-spheroid.
+	 */
+
+	void generateSol10( CBiteRnd& rnd )
+	{
+		ptype* const Params = TmpParams;
+
+		const ptype* const rp1 = getParamsOrdered(
+			rnd.getSqrInt( CurPopSize ));
+
+		const ptype* const rp2 = getParamsOrdered(
+			rnd.getSqrIntInv( CurPopSize ));
+
+		int i;
+
+		// Calculate centroid.
+
+		for( i = 0; i < ParamCount; i++ )
+		{
+			Params[ i ] = ( rp1[ i ] + rp2[ i ]) >> 1;
+		}
+
+		// Calculate radius.
+
+		double Radius = 0.0;
+
+		for( i = 0; i < ParamCount; i++ )
+		{
+			const ptype v1 = rp1[ i ] - Params[ i ];
+			const ptype v2 = rp2[ i ] - Params[ i ];
+			Radius += (double) v1 * v1 + 0.45 * v2 * v2;
+		}
+
+		// Select a point on a hyper-spheroid.
+
+		double s2 = 1e-300;
+
+		rnd.fillUniform( NewValues, ParamCount );
+
+		for( i = 0; i < ParamCount; i++ )
+		{
+			NewValues[ i ] -= 0.5;
+			s2 += NewValues[ i ] * NewValues[ i ];
+		}
+
+		// Add hyper-spheroid-based offset to the centroid.
+
+		const double d = sqrt( Radius / s2 );
+
+		for( i = 0; i < ParamCount; i++ )
+		{
+			Params[ i ] += (ptype) ( NewValues[ i ] * d );
+		}
+	}
+
+	/**
+	 * Stochastic PSO-alike solution generator. Moves a randomly-selected
+	 * existing solution towards a better solution, and at the same times
+	 * makes a move in a random direction having a magnitude derived as a
+	 * distance between a better and worse solutions (limits the magnitude to
+	 * the current basin of solutions).
+	 */
+
+	void generateSol11( CBiteRnd& rnd )
+	{
+		ptype* const Params = TmpParams;
+
+		const ptype* const rp0 = getParamsOrdered(
+			rnd.getInt( CurPopSize ));
+
+		const ptype* const rp1 = getParamsOrdered(
+			rnd.getPowInt( 4.0, CurPopSize ));
+
+		const ptype* const rp2 = getParamsOrdered(
+			rnd.getSqrIntInv( CurPopSize ));
+
+		double s1 = 1e-300;
+		double s2 = 1e-300;
+		double d;
+		int i;
+
+		rnd.fillUniform( NewValues, ParamCount );
+
+		for( i = 0; i < ParamCount; i++ )
+		{
+			d = (double) ( rp1[ i ] - rp2[ i ]);
+			s1 += d * d;
+
+			NewValues[ i ] -= 0.5;
+			s2 += NewValues[ i ] * NewValues[ i ];
+		}
+
+		const double m1 = sqrt( ParamCountI ) * 0.5;
+		const double m0 = 1.0 - m1;
+		d = sqrt( s1 * ParamCountI / s2 ) * 2.0;
+
+		for( i = 0; i < ParamCount; i++ )
+		{
+			Params[ i ] = (ptype) ( rp0[ i ] * m0 + rp1[ i ] * m1 +
+				NewValues[ i ] * d );
+		}
+	}
+
+	/**
+	 * Solution generator that estimates population's standard deviation using
+	 * better and worse solutions, and then generates a solution using
+	 * Gaussian sampling around centroid.
+	 */
+
+	void generateSol12( CBiteRnd& rnd )
+	{
+		ptype* const Params = TmpParams;
+
+		const ptype* const rp1 = getParamsOrdered(
+			rnd.getSqrInt( CurPopSize ));
+
+		const ptype* const rp2 = getParamsOrdered(
+			rnd.getSqrIntInv( CurPopSize ));
+
+		const ptype* const rpc = getCentroid();
+		double r = 0.0;
+		int i;
+
+		for( i = 0; i < ParamCount; i++ )
+		{
+			const double d1 = (double) ( rp2[ i ] - rp1[ i ]);
+			r += d1 * d1;
+		}
+
+		r = sqrt( r / ParamCount );
+
+		rnd.fillGaussian( NewValues, ParamCount );
+
+		for( i = 0; i < ParamCount; i++ )
+		{
+			Params[ i ] = rpc[ i ] + (ptype) ( NewValues[ i ] * r );
+		}
+	}
+
+	/**
+	 * Solution generator that applies Differential Evolution in real
+	 * parameter value space, in a randomized fashion: each parameter value
+	 * receives a DE operation value of a randomly-chosen parameter. This
+	 * solution generator is moderately effective even on its own.
+	 */
+
+	void generateSol13( CBiteRnd& rnd )
+	{
+		ptype* const Params = TmpParams;
+
+		const CBitePop& ParPop = selectParPop( 7, rnd );
+		const int ParPopSize = ParPop.getCurPopSize();
+
+		const ptype* const rp1 = getParamsOrdered(
+			rnd.getSqrInt( CurPopSize ));
+
+		const int kc = 4;
+		const ptype* rp2[ kc ];
+		const ptype* rp3[ kc ];
+		int i;
+
+		for( i = 0; i < kc; i++ )
+		{
+			rp2[ i ] = ParPop.getParamsOrdered(
+				rnd.getLogInt( ParPopSize ));
+
+			rp3[ i ] = ParPop.getParamsOrdered( ParPopSize - 1 -
+				rnd.getLogInt( ParPopSize ));
+		}
+
+		for( i = 0; i < ParamCount; i++ )
+		{
+			const int j = rnd.getInt( ParamCount );
+			const int k = rnd.getInt( kc );
+
+			Params[ i ] = (ptype) (( getRealValue( rp1, i ) +
+				( getRealValue( rp2[ k ], j ) -
+				getRealValue( rp3[ k ], j )) * 0.5 - MinValues[ i ]) *
+				DiffValuesI[ i ]);
+		}
+	}
+
+	/**
+	 * Solution generator that obtains solution from an independently-running
+	 * parallel optimizer.
+	 */
+
+	void generateSolPar( CBiteRnd& rnd )
+	{
+		DoEval = false;
+		CBitePop* UpdPop;
+
+		if( UseParOpt == 1 )
+		{
+			// Re-assign optimizer 2 based on comparison of its
+			// efficiency with optimizer 1.
+
+			UseParOpt = select( ParOpt2Sel, rnd );
+		}
+
+		const int64_t tt0 = ( Tracer != NULL ?
+			CBiteTracer :: getTimestamp() : 0 );
+
+		if( UseParOpt == 0 )
+		{
+			const int64_t sc = ParOpt.optimize( rnd );
+
+			if( Tracer != NULL )
+			{
+				Tracer -> addSpan( "ParOpt", tt0 );
+			}
+
+			LastCosts = ParOpt.getLastCosts();
+			LastValues = ParOpt.getLastValues();
+
+			if( sc != 0 )
+			{
+				UseParOpt = 1; // On stall, select optimizer 2.
+
+				if( sc > ParamCount * 64 )
+				{
+					if( Tracer != NULL )
+					{
+						Tracer -> addInstant( "ParOpt restart" );
+					}
+
+					ParOpt.init( rnd, getBestParams(), StartSD * 2.0 );
+					ParOptPop.resetCurPopPos();
+				}
+			}
+
+			UpdPop = &ParOptPop;
+		}
+		else
+		{
+			const int64_t sc = ParOpt2.optimize( rnd );
+
+			if( Tracer != NULL )
+			{
+				Tracer -> addSpan( "ParOpt2", tt0 );
+			}
+
+			LastCosts = ParOpt2.getLastCosts();
+			LastValues = ParOpt2.getLastValues();
+
+			if( sc != 0 )
+			{
+				UseParOpt = 0; // On stall, select optimizer 1.
+
+				if( sc > ParamCount * 128 )
+				{
+					if( Tracer != NULL )
+					{
+						Tracer -> addInstant( "ParOpt2 restart" );
+					}
+
+					ParOpt2.init( rnd, getBestParams(), StartSD * 4.0 );
+					ParOpt2Pop.resetCurPopPos();
+				}
+			}
+
+			UpdPop = &ParOpt2Pop;
+		}
+
+		int i;
+
+		for( i = 0; i < ParamCount; i++ )
+		{
+			TmpParams[ i ] = (ptype) (( LastValues[ i ] - MinValues[ i ]) *
+				DiffValuesI[ i ]);
+		}
+
+		snapParams( TmpParams );
+
+		UpdPop -> updatePop( LastCosts[ 0 ], TmpParams, false );
+	}
+};
+
+/**
+ * Parameter mask adapter class. Presents the active parameters of the
+ * owner's parameter vector as a compact parameter vector, to optimizers that
+ * it owns; frozen parameters are held at fixed values. Optimizers then work
+ * in the reduced dimension, with all kernels skipping frozen parameters.
+ * Without a mask, the adapter forwards all calls unchanged.
+ */
+
+class CBiteOptMaskAdapter : public CBiteOptInterface
+{
+public:
+	CBiteOptMaskAdapter( CBiteOptInterface* const aOwner )
+		: Owner( aOwner )
+		, ParamCount( 0 )
+		, ActiveCount( 0 )
+		, ActiveIdx( NULL )
+		, FullValues( NULL )
+		, FullBuf( NULL )
+	{
+	}
+
+	virtual ~CBiteOptMaskAdapter()
+	{
+		deleteBuffers();
+	}
+
+	/**
+	 * Function updates the owner's dimensionality, and removes the mask.
+	 * Function does nothing if dimensionality has not changed since the last
+	 * call.
+	 *
+	 * @param aParamCount The number of the owner's parameters.
+	 */
+
+	void updateDims( const int aParamCount )
+	{
+		if( aParamCount == ParamCount )
+		{
+			return;
+		}
+
+		deleteBuffers();
+
+		ParamCount = aParamCount;
+		ActiveIdx = new int[ ParamCount ];
+		FullValues = new double[ ParamCount ];
+		FullBuf = new double[ ParamCount ];
+
+		setMask( NULL, NULL );
+	}
+
+	/**
+	 * Function sets the parameter mask.
+	 *
+	 * @param Active Parameter activity flags, ParamCount elements: "false"
+	 * freezes the parameter. NULL removes the mask.
+	 * @param Values Values of frozen parameters, ParamCount elements (values
+	 * of active parameters are ignored). Can be NULL, if Active is NULL.
+	 */
+
+	void setMask( const bool* const Active, const double* const Values )
+	{
+		ActiveCount = 0;
+		int i;
+
+		for( i = 0; i < ParamCount; i++ )
+		{
+			if( Active == NULL || Active[ i ])
+			{
+				ActiveIdx[ ActiveCount ] = i;
+				ActiveCount++;
+			}
+
+			FullValues[ i ] = ( Values != NULL ? Values[ i ] : 0.0 );
+		}
+	}
+
+	/**
+	 * @return "True" if some parameters are frozen.
+	 */
+
+	bool isMasked() const
+	{
+		return( ActiveCount < ParamCount );
+	}
+
+	/**
+	 * @return The number of active parameters.
+	 */
+
+	int getActiveCount() const
+	{
+		return( ActiveCount );
+	}
+
+	/**
+	 * @return Active parameter indices within the owner's parameter vector,
+	 * getActiveCount() elements.
+	 */
+
+	const int* getActiveIdx() const
+	{
+		return( ActiveIdx );
+	}
+
+	/**
+	 * Function converts a compact parameter vector to the owner's vector.
+	 *
+	 * @param p Compact vector, getActiveCount() elements.
+	 * @param[out] full Owner's vector, ParamCount elements.
+	 */
+
+	void unpack( const double* const p, double* const full ) const
+	{
+		memcpy( full, FullValues, ParamCount * sizeof( full[ 0 ]));
+
+		int i;
+
+		for( i = 0; i < ActiveCount; i++ )
+		{
+			full[ ActiveIdx[ i ]] = p[ i ];
+		}
+	}
+
+	/**
+	 * Function converts the owner's parameter vector to a compact vector.
+	 *
+	 * @param full Owner's vector, ParamCount elements.
+	 * @param[out] p Compact vector, getActiveCount() elements.
+	 */
+
+	void pack( const double* const full, double* const p ) const
+	{
+		int i;
+
+		for( i = 0; i < ActiveCount; i++ )
+		{
+			p[ i ] = full[ ActiveIdx[ i ]];
+		}
+	}
+
+	virtual const double* getBestParams() const
+	{
+		return( Owner -> getBestParams() );
+	}
+
+	virtual double getBestCost() const
+	{
+		return( Owner -> getBestCost() );
+	}
+
+	virtual const double* getLastCosts() const
+	{
+		return( Owner -> getLastCosts() );
+	}
+
+	virtual const double* getLastValues() const
+	{
+		return( Owner -> getLastValues() );
+	}
+
+	virtual void getMinValues( double* const p ) const
+	{
+		if( isMasked() )
+		{
+			Owner -> getMinValues( FullBuf );
+			pack( FullBuf, p );
+		}
+		else
+		{
+			Owner -> getMinValues( p );
+		}
+	}
+
+	virtual void getMaxValues( double* const p ) const
+	{
+		if( isMasked() )
+		{
+			Owner -> getMaxValues( FullBuf );
+			pack( FullBuf, p );
+		}
+		else
+		{
+			Owner -> getMaxValues( p );
+		}
+	}
+
+	virtual double optcost( const double* const p )
+	{
+		return( Owner -> optcost( getFull( p )));
+	}
+
+	virtual double optrank( const double* const p )
+	{
+		return( Owner -> optrank( getFull( p )));
+	}
+
+	virtual void optcns( const double* const p, double* const c )
+	{
+		Owner -> optcns( getFull( p ), c );
+	}
+
+	virtual void optobjs( const double* const p, double* const objs )
+	{
+		Owner -> optobjs( getFull( p ), objs );
+	}
+
+	virtual bool isCostBoundUsed() const
+	{
+		return( Owner -> isCostBoundUsed() );
+	}
+
+protected:
+	CBiteOptInterface* Owner; ///< Owner object.
+	int ParamCount; ///< The number of the owner's parameters.
+	int ActiveCount; ///< The number of active parameters.
+	int* ActiveIdx; ///< Active parameter indices.
+	double* FullValues; ///< Owner's vector holding frozen values.
+	double* FullBuf; ///< Owner's vector buffer, for conversions.
+
+	/**
+	 * Function returns the owner's vector for the specified compact vector;
+	 * the returned pointer is valid until the next call.
+	 *
+	 * @param p Compact vector.
+	 */
+
+	const double* getFull( const double* const p ) const
+	{
+		if( !isMasked() )
+		{
+			return( p );
+		}
+
+		unpack( p, FullBuf );
+
+		return( FullBuf );
+	}
+
+	void deleteBuffers()
+	{
+		delete[] ActiveIdx;
+		delete[] FullValues;
+		delete[] FullBuf;
+	}
+};
+
+/**
+ * Deep optimization class. Based on an array of M CBiteOpt objects. This
+ * "deep" method pushes the newly-obtained solution to the next CBiteOpt
+ * object which is then optimized.
+ *
+ * Description is available at https://github.com/avaneev/biteopt
+ */
+
+class CBiteOptDeep : public CBiteOptInterface
+{
+public:
+	CBiteOptDeep()
+		: ParamCount( 0 )
+		, OptCount( 0 )
+		, CnsCount( 0 )
+		, ObjCount( 1 )
+		, OptPopSize( 0 )
+		, Opts( NULL )
+		, EvalCacheSize( 0 )
+		, DoPrescreen( false )
+		, DoGenStats( false )
+		, Tracer( NULL )
+		, ParetoSize( 256 )
+		, MaskAdapter( this )
+		, MaskBuf( NULL )
+		, BestBuf( NULL )
+		, LastBuf( NULL )
+		, ParamTypes( NULL )
+		, OptParamTypes( NULL )
+	{
+	}
+
+	virtual ~CBiteOptDeep()
+	{
+		deleteBuffers();
+	}
+
+	virtual const double* getBestParams() const
+	{
+		if( MaskAdapter.isMasked() )
+		{
+			MaskAdapter.unpack( BestOpt -> getBestParams(), BestBuf );
+			return( BestBuf );
+		}
+
+		return( BestOpt -> getBestParams() );
+	}
+
+	virtual double getBestCost() const
+	{
+		return( BestOpt -> getBestCost() );
+	}
+
+	virtual const double* getLastCosts() const
+	{
+		return( LastOpt -> getLastCosts() );
+	}
+
+	virtual const double* getLastValues() const
+	{
+		if( MaskAdapter.isMasked() )
+		{
+			MaskAdapter.unpack( LastOpt -> getLastValues(), LastBuf );
+			return( LastBuf );
+		}
+
+		return( LastOpt -> getLastValues() );
+	}
+
+	virtual double getCostBound() const
+	{
+		return( CurOpt -> getCostBound() );
+	}
+
+	virtual int getDeltaParent( double* const ParentValues,
+		double* const ParentCost, int* const Changed ) const
+	{
+		if( !MaskAdapter.isMasked() )
+		{
+			return( CurOpt -> getDeltaParent( ParentValues, ParentCost,
+				Changed ));
+		}
+
+		const int nc = CurOpt -> getDeltaParent( MaskBuf, ParentCost,
+			Changed );
+
+		if( nc >= 0 )
+		{
+			MaskAdapter.unpack( MaskBuf, ParentValues );
+
+			const int* const ai = MaskAdapter.getActiveIdx();
+			int i;
+
+			for( i = 0; i < nc; i++ )
+			{
+				Changed[ i ] = ai[ Changed[ i ]];
+			}
+		}
+
+		return( nc );
+	}
+
+	/**
+	 * Function sets the parameter mask, to optimize a subset of parameters
+	 * while others are held at fixed values. Frozen parameters are excluded
+	 * from all optimizer kernels: CBiteOpt objects are re-dimensioned to the
+	 * number of active parameters, with the population size following it.
+	 * The re-dimensioning reuses buffers allocated for all parameters by the
+	 * updateDims() function, so mask changes do not reallocate memory.
+	 * Should be called after the updateDims() function, and followed by the
+	 * init() function call. The mask is removed on dimensionality change.
+	 * Clears the evaluation cache. Not available in multi-objective mode.
+	 *
+	 * @param Active Parameter activity flags, ParamCount elements: "false"
+	 * freezes the parameter. NULL removes the mask.
+	 * @param Values Values of frozen parameters, ParamCount elements (values
+	 * of active parameters are ignored). Can be NULL, if Active is NULL.
+	 * @return "False" if the mask cannot be set: no parameters are active,
+	 * or multi-objective mode is in use.
+	 */
+
+	bool setParamMask( const bool* const Active, const double* const Values )
+	{
+		if( Active != NULL )
+		{
+			int c = 0;
+			int i;
 
 			for( i = 0; i < ParamCount; i++ )
 			{
-				Params[ i ] = ( rnd.get() < p ? cp[ i ] :
-					rp1[ i ] + ( rp1[ i ] - rp2[ i ]));
+				c += ( Active[ i ] ? 1 : 0 );
+			}
+
+			if( c == 0 || ObjCount > 1 )
+			{
+				return( false );
 			}
 		}
+
+		MaskAdapter.setMask( Active, Values );
+
+		const int k = MaskAdapter.getActiveCount();
+		int i;
+
+		for( i = 0; i < OptCount; i++ )
+		{
+			Opts[ i ] -> updateDims( k, OptPopSize, CnsCount, ObjCount );
+		}
+
+		applyEvalCache();
+		applyParamTypes();
+		EvalCache.clear();
+
+		return( true );
+	}
+
+	/**
+	 * Function assigns parameter types to all CBiteOpt objects, see
+	 * CBiteOpt::setParamTypes(). Should be called after the updateDims()
+	 * function; types are reset on dimensionality change. Clears the
+	 * evaluation cache, if types were changed.
+	 *
+	 * @param Types Parameter types, ParamCount elements, see EParamType.
+	 * NULL if all parameters are continuous. The array is copied.
+	 */
+
+	void setParamTypes( const int* const Types )
+	{
+		if( Types == NULL ? ParamTypes == NULL : ParamTypes != NULL &&
+			memcmp( Types, ParamTypes, ParamCount * sizeof( Types[ 0 ])) == 0 )
+		{
+			return;
+		}
+
+		delete[] ParamTypes;
+		ParamTypes = NULL;
+
+		if( Types != NULL )
+		{
+			ParamTypes = new int[ ParamCount ];
+			memcpy( ParamTypes, Types, ParamCount * sizeof( ParamTypes[ 0 ]));
+		}
+
+		applyParamTypes();
+		EvalCache.clear();
+	}
+
+	/**
+	 * @return The number of objective function evaluations of duplicate
+	 * discrete solutions avoided, in all CBiteOpt objects.
+	 */
+
+	int64_t getDupSaved() const
+	{
+		int64_t s = 0;
+		int i;
+
+		for( i = 0; i < OptCount; i++ )
+		{
+			s += Opts[ i ] -> getDupSaved();
+		}
+
+		return( s );
+	}
+
+	/**
+	 * @return The number of active (not frozen) parameters, see
+	 * setParamMask().
+	 */
+
+	int getActiveParamCount() const
+	{
+		return( MaskAdapter.getActiveCount() );
+	}
+
+	/**
+	 * Function returns a pointer to an array of selectors in use by the
+	 * current CBiteOpt object.
+	 */
+
+	CBiteSelBase** getSels()
+	{
+		return( CurOpt -> getSels() );
+	}
+
+	/**
+	 * Function returns a pointer to an array of selector names.
+	 */
+
+	const char** getSelNames() const
+	{
+		return( CurOpt -> getSelNames() );
+	}
+
+	/**
+	 * Function returns the number of selectors in use by the current CBiteOpt
+	 * object.
+	 */
+
+	int getSelCount() const
+	{
+		return( CurOpt -> getSelCount() );
+	}
+
+	/**
+	 * Function sets the size of the evaluation cache, shared by all CBiteOpt
+	 * objects. The cache holds objective function values of the recently
+	 * evaluated solutions, and returns them for exactly matching solutions,
+	 * without calling the optcost() function again. The cache is preserved
+	 * across init() calls, and is cleared on dimensionality or size change,
+	 * or via the clearEvalCache() function.
+	 *
+	 * @param Size The maximal number of solutions to cache, 0 disables the
+	 * cache.
+	 */
+
+	void setEvalCacheSize( const int Size )
+	{
+		EvalCacheSize = Size;
+
+		if( Opts != NULL )
+		{
+			applyEvalCache();
+		}
+	}
+
+	/**
+	 * Function removes all solutions from the evaluation cache, and resets
+	 * its counters. Should be called if the objective function or parameter
+	 * bounds were changed.
+	 */
+
+	void clearEvalCache()
+	{
+		EvalCache.clear();
+	}
+
+	/**
+	 * @return The number of evaluations served from the evaluation cache.
+	 */
+
+	int64_t getEvalCacheHits() const
+	{
+		return( EvalCache.getHitCount() );
+	}
+
+	/**
+	 * @return The number of evaluation cache lookups that required the
+	 * objective function evaluation.
+	 */
+
+	int64_t getEvalCacheMisses() const
+	{
+		return( EvalCache.getMissCount() );
+	}
+
+	/**
+	 * Function enables or disables surrogate pre-screening in all CBiteOpt
+	 * objects, see CBiteOpt::setPrescreen().
+	 *
+	 * @param aDoPrescreen "True" to enable pre-screening.
+	 */
+
+	void setPrescreen( const bool aDoPrescreen )
+	{
+		DoPrescreen = aDoPrescreen;
+
+		int i;
+
+		for( i = 0; i < OptCount; i++ )
+		{
+			Opts[ i ] -> setPrescreen( DoPrescreen );
+		}
 	}
 
 	/**
-	 * "Entropy bit mixing"-based solution generator. Performs crossing-over
-	 * of an odd number (this is important) of random solutions via XOR
-	 * operation. Slightly less effective than the DE-based mixing, but makes
-	 * the optimization method more diverse overall.
+	 * @return The number of objective function evaluations avoided via
+	 * pre-screening, in all CBiteOpt objects.
 	 */
 
-	void generateSol4( CBiteRnd& rnd )
+	int64_t getPrescreenSaved() const
 	{
-		ptype* const Params = TmpParams;
+		int64_t s = 0;
+		int i;
 
-		const CBitePop* UsePops[ 2 ];
-		UsePops[ 0 ] = &selectAltPop( 1, rnd );
-		UsePops[ 1 ] = &selectParPop( 3, rnd );
+		for( i = 0; i < OptCount; i++ )
+		{
+			s += Opts[ i ] -> getPrescreenSaved();
+		}
 
-		int UseSize[ 2 ];
-		UseSize[ 0 ] = CurPopSize;
-		UseSize[ 1 ] = UsePops[ 1 ] -> getCurPopSize();
+		return( s );
+	}
 
-		const int km = 3 + ( select( Gen4MixFacSel, rnd ) << 1 );
+	/**
+	 * Function enables or disables solution generator statistics collection
+	 * in all CBiteOpt objects, see CBiteOpt::setGenStats(). Statistics of
+	 * all CBiteOpt objects are accumulated together.
+	 *
+	 * @param aDoGenStats "True" to enable statistics collection.
+	 */
 
-		int p = rnd.getBit();
-		const ptype* rp1 = UsePops[ p ] -> getParamsOrdered(
-			rnd.getSqrInt( UseSize[ p ]));
+	void setGenStats( const bool aDoGenStats )
+	{
+		DoGenStats = aDoGenStats;
 
-		copyParams( Params, rp1 );
-		int k;
+		int i;
 
-		for( k = 1; k < km; k++ )
+		for( i = 0; i < OptCount; i++ )
 		{
-			p = rnd.getBit();
-			rp1 = UsePops[ p ] -> getParamsOrdered(
-				rnd.getSqrInt( UseSize[ p ]));
+			Opts[ i ] -> setGenStats( DoGenStats ? &GenStats : NULL );
+		}
+	}
 
-			int i;
+	/**
+	 * @return Solution generator statistics, accumulated since *this
+	 * object's construction, or the latest clearGenStats() call.
+	 */
 
-			for( i = 0; i < ParamCount; i++ )
-			{
-				Params[ i ] ^= rp1[ i ];
-			}
-		}
+	const CBiteGenStats& getGenStats() const
+	{
+		return( GenStats );
+	}
 
-		// Simple XOR randomize.
+	/**
+	 * Function resets solution generator statistics.
+	 */
 
-		int b = rnd.getSqrInt( 54 );
-		b = ( b > IntMantBits ? IntMantBits : b );
+	void clearGenStats()
+	{
+		GenStats.clear();
+	}
 
-		Params[ rnd.getInt( ParamCount )] ^=
-			( rnd.getRaw() & IntMantMask ) >> b;
+	/**
+	 * @return Generator of the solution being currently evaluated, see
+	 * CBiteOpt::getEvalGen().
+	 */
+
+	int getEvalGen() const
+	{
+		return( CurOpt -> getEvalGen() );
 	}
 
 	/**
-	 * A novel "Randomized bit crossing-over" candidate solution generation
-	 * method. Effective, but on its own cannot stand coordinate system
-	 * offsets, converges slowly. Completely mixes bits of two
-	 * randomly-selected solutions, plus changes 1 random bit.
+	 * Function assigns a timeline tracer to all CBiteOpt objects, see
+	 * CBiteOpt::setTracer().
 	 *
-	 * This method is similar to a biological DNA crossing-over, but on a
-	 * single-bit scale.
+	 * @param aTracer Tracer, NULL to disable tracing.
 	 */
 
-	void generateSol5( CBiteRnd& rnd )
+	void setTracer( CBiteTracer* const aTracer )
 	{
-		ptype* const Params = TmpParams;
+		Tracer = aTracer;
 
-		const CBitePop& ParPop = selectParPop( 4, rnd );
-
-		const ptype* const CrossParams1 = ParPop.getParamsOrdered(
-			rnd.getSqrInt( ParPop.getCurPopSize() ));
+		int i;
 
-		const CBitePop& AltPop = selectAltPop( 2, rnd );
+		for( i = 0; i < OptCount; i++ )
+		{
+			Opts[ i ] -> setTracer( Tracer );
+		}
+	}
 
-		const ptype* const CrossParams2 = AltPop.getParamsOrdered(
-			rnd.getSqrInt( CurPopSize ));
+	/**
+	 * Function checks the population collapse stopping criteria of all
+	 * CBiteOpt objects, see CBiteOpt::isConverged().
+	 *
+	 * @param ftol Relative rank spread threshold, 0 to disable.
+	 * @param xtol Parameter spread threshold, 0 to disable.
+	 * @return "True" if all populations have collapsed.
+	 */
 
+	bool isConverged( const double ftol, const double xtol )
+	{
 		int i;
 
-		for( i = 0; i < ParamCount; i++ )
+		for( i = 0; i < OptCount; i++ )
 		{
-			// Produce a random bit-mixing mask.
-
-			const ptype crpl = rnd.getRaw() & IntMantMask;
+			if( !Opts[ i ] -> isConverged( ftol, xtol ))
+			{
+				return( false );
+			}
+		}
 
-			Params[ i ] = ( CrossParams1[ i ] & crpl ) |
-				( CrossParams2[ i ] & ~crpl );
+		return( true );
+	}
 
-			// Randomize a single bit, in TPDF manner.
+	/**
+	 * Function sets the capacity of the Pareto archive, shared by all
+	 * CBiteOpt objects in multi-objective mode, see
+	 * CBiteOpt::setParetoArchive(). The archive is preserved across init()
+	 * calls, and is cleared on dimensionality or capacity change, or via the
+	 * clearParetoArchive() function.
+	 *
+	 * @param Size The maximal number of solutions in the archive.
+	 */
 
-			const int b = rnd.getInt( IntMantBits );
+	void setParetoSize( const int Size )
+	{
+		ParetoSize = Size;
 
-			Params[ i ] += ( (ptype) rnd.getBit() << b ) -
-				( (ptype) rnd.getBit() << b );
+		if( Opts != NULL )
+		{
+			applyParetoArchive();
 		}
 	}
 
 	/**
-	 * "Randomized parameter cross-over" solution generator. Similar to the
-	 * "randomized bit cross-over", but works with the whole parameter values.
+	 * Function removes all solutions from the Pareto archive.
 	 */
 
-	void generateSol5b( CBiteRnd& rnd )
+	void clearParetoArchive()
 	{
-		ptype* const Params = TmpParams;
-		const ptype* CrossParams[ 4 ];
+		ParetoArchive.clear();
+	}
 
-		const CBitePop& ParPop = selectParPop( 5, rnd );
-		const int ParPopSize = ParPop.getCurPopSize();
+	/**
+	 * @return The Pareto archive: non-dominated solutions found so far, in
+	 * multi-objective mode.
+	 */
 
-		CrossParams[ 0 ] = ParPop.getParamsOrdered(
-			rnd.getSqrInt( ParPopSize ));
+	const CBiteParetoArchive& getParetoArchive() const
+	{
+		return( ParetoArchive );
+	}
 
-		const CBitePop& AltPop = selectAltPop( 3, rnd );
+	/**
+	 * Function updates dimensionality of *this object. Function does nothing
+	 * if dimensionality has not changed since the last call. This function
+	 * should be called at least once before calling the init() function.
+	 *
+	 * @param aParamCount The number of parameters being optimized.
+	 * @param M The number of CBiteOpt objects. This number depends on the
+	 * complexity of the objective function, if the default value does not
+	 * produce a good solution, it should be increased together with the
+	 * iteration count. Minimal value is 1, in this case a plain CBiteOpt
+	 * optimization will be performed.
+	 * @param PopSize0 The number of elements in population to use. If set to
+	 * 0, the default formula will be used.
+	 * @param aCnsCount The number of constraints, see the optcns() function.
+	 * @param aObjCount The number of objectives, see the optobjs() function.
+	 */
 
-		if( rnd.getBit() )
+	void updateDims( const int aParamCount, const int M = 6,
+		const int PopSize0 = 0, const int aCnsCount = 0,
+		const int aObjCount = 1 )
+	{
+		if( aParamCount == ParamCount && M == OptCount &&
+			aCnsCount == CnsCount && aObjCount == ObjCount )
 		{
-			CrossParams[ 1 ] = AltPop.getParamsOrdered(
-				rnd.getSqrIntInv( CurPopSize ));
+			return;
 		}
-		else
+
+		deleteBuffers();
+
+		ParamCount = aParamCount;
+		OptCount = M;
+		CnsCount = aCnsCount;
+		ObjCount = aObjCount;
+		OptPopSize = PopSize0;
+		Opts = new CBiteOptOwned< CBiteOpt >*[ OptCount ];
+		MaskAdapter.updateDims( aParamCount );
+		MaskAdapter.setMask( NULL, NULL );
+		MaskBuf = new double[ aParamCount ];
+		BestBuf = new double[ aParamCount ];
+		LastBuf = new double[ aParamCount ];
+		OptParamTypes = new int[ aParamCount ];
+
+		int i;
+
+		for( i = 0; i < OptCount; i++ )
 		{
-			CrossParams[ 1 ] = AltPop.getParamsOrdered(
-				rnd.getSqrInt( CurPopSize ));
+			Opts[ i ] = new CBiteOptOwned< CBiteOpt >( &MaskAdapter );
+			Opts[ i ] -> updateDims( aParamCount, PopSize0, aCnsCount,
+				aObjCount );
+
+			Opts[ i ] -> setPrescreen( DoPrescreen );
+			Opts[ i ] -> setGenStats( DoGenStats ? &GenStats : NULL );
+			Opts[ i ] -> setTracer( Tracer );
 		}
 
-		const int Mode = select( Gen5bModeSel, rnd );
+		applyEvalCache();
+		applyParetoArchive();
+	}
+
+	/**
+	 * Function initializes *this optimizer. Performs N=PopSize objective
+	 * function evaluations.
+	 *
+	 * @param rnd Random number generator.
+	 * @param InitParams Initial parameter values.
+	 * @param InitRadius Initial radius, relative to the default value.
+	 */
+
+	void init( CBiteRnd& rnd, const double* InitParams = NULL,
+		const double InitRadius = 1.0 )
+	{
 		int i;
 
-		if( Mode == 0 )
+		if( InitParams != NULL && MaskAdapter.isMasked() )
 		{
-			for( i = 0; i < ParamCount; i++ )
-			{
-				Params[ i ] = CrossParams[ rnd.getBit() ][ i ];
-			}
+			MaskAdapter.pack( InitParams, MaskBuf );
+			InitParams = MaskBuf;
 		}
-		else
+
+		for( i = 0; i < OptCount; i++ )
 		{
-			CrossParams[ 2 ] = ParPop.getParamsOrdered(
-				rnd.getSqrInt( ParPopSize ));
+			Opts[ i ] -> init( rnd, InitParams, InitRadius );
+		}
 
-			CrossParams[ 3 ] = AltPop.getParamsOrdered(
-				rnd.getSqrInt( CurPopSize ));
+		BestOpt = Opts[ 0 ];
+		CurOpt = Opts[ 0 ];
+		LastOpt = CurOpt;
+		StallCount = 0;
 
-			for( i = 0; i < ParamCount; i++ )
+		if( OptCount == 1 )
+		{
+			PushOpt = CurOpt;
+		}
+		else
+		{
+			while( true )
 			{
-				Params[ i ] = CrossParams[ rnd.getBit() << 1 |
-					rnd.getBit() ][ i ];
+				PushOpt = Opts[ rnd.getInt( OptCount )];
+
+				if( PushOpt != CurOpt )
+				{
+					break;
+				}
 			}
 		}
-
-		// Simple XOR randomize.
-
-		int b = rnd.getSqrInt( 54 );
-		b = ( b > IntMantBits ? IntMantBits : b );
-
-		Params[ rnd.getInt( ParamCount )] ^=
-			( rnd.getRaw() & IntMantMask ) >> b;
 	}
 
 	/**
-	 * "Genetic crossing-over" candidate solution generation method.
-	 * Completely mixes parameter parts of two randomly-selected solutions,
-	 * at random crossover point, plus adds a random step. This method is
-	 * similar to generator 5.
+	 * Function performs the parameter optimization iteration that involves 1
+	 * objective function evaluation.
+	 *
+	 * @param rnd Random number generator.
+	 * @return The number of non-improving iterations so far. The plateau
+	 * threshold value is ParamCount * 64.
 	 */
 
-	void generateSol5c( CBiteRnd& rnd )
+	int64_t optimize( CBiteRnd& rnd )
 	{
-		ptype* const Params = TmpParams;
-
-		const CBitePop& ParPop = selectParPop( 6, rnd );
-		const int ParPopSize = ParPop.getCurPopSize();
-
-		const ptype* const rp1 = ParPop.getParamsOrdered(
-			rnd.getSqrInt( ParPopSize ));
-
-		const ptype* const rp2 = ParPop.getParamsOrdered(
-			rnd.getSqrInt( ParPopSize ));
+		if( OptCount == 1 )
+		{
+			StallCount = Opts[ 0 ] -> optimize( rnd );
 
-		const ptype* const rp3 = ParPop.getParamsOrdered(
-			rnd.getSqrIntInv( ParPopSize ));
+			return( StallCount );
+		}
 
-		int i;
+		const int64_t sc = CurOpt -> optimize( rnd, PushOpt );
+		LastOpt = CurOpt;
 
-		for( i = 0; i < ParamCount; i++ )
+		if( CurOpt -> getBestCost() <= BestOpt -> getBestCost() )
 		{
-			// Produce a bit-mixing mask.
+			BestOpt = CurOpt;
+		}
 
-			ptype crm = ( (ptype) 1 << rnd.getInt( IntMantBits )) - 1;
+		if( sc == 0 )
+		{
+			StallCount = 0;
+		}
+		else
+		{
+			StallCount++;
+			CurOpt = PushOpt;
 
-			if( rnd.getBit() )
+			if( OptCount == 2 )
 			{
-				crm ^= IntMantMask;
+				PushOpt = Opts[ CurOpt == Opts[ 0 ]];
 			}
+			else
+			{
+				while( true )
+				{
+					PushOpt = Opts[ rnd.getInt( OptCount )];
 
-			Params[ i ] = ( rp1[ i ] & crm ) | ( rp2[ i ] & ~crm );
-
-			// Randomize, depending on difference between better and worse
-			// parameter values.
-
-			Params[ i ] += (ptype) (( rp1[ i ] - rp3[ i ]) * rnd.getTPDF() );
+					if( PushOpt != CurOpt )
+					{
+						break;
+					}
+				}
+			}
 		}
+
+		return( StallCount );
 	}
 
+protected:
+	int ParamCount; ///< The total number of internal parameter values in use.
+	int OptCount; ///< The total number of optimization objects in use.
+	int CnsCount; ///< The number of constraints.
+	int ObjCount; ///< The number of objectives.
+	int OptPopSize; ///< Population size of CBiteOpt objects, 0 if
+		///< default.
+	CBiteOptOwned< CBiteOpt >** Opts; ///< Optimization objects.
+	CBiteOptOwned< CBiteOpt >* BestOpt; ///< Optimizer that contains the best
+		///< solution.
+	CBiteOptOwned< CBiteOpt >* CurOpt; ///< Current optimizer object.
+	CBiteOptOwned< CBiteOpt >* PushOpt; ///< Optimizer where solution is
+		///< pushed to.
+	CBiteOptOwned< CBiteOpt >* LastOpt; ///< Latest optimizer object.
+	int64_t StallCount; ///< The number of iterations without improvement.
+	CBiteEvalCache< double > EvalCache; ///< Evaluation cache, shared by
+		///< all optimization objects.
+	int EvalCacheSize; ///< Evaluation cache's size, 0 if not in use.
+	bool DoPrescreen; ///< "True" if surrogate pre-screening is enabled.
+	bool DoGenStats; ///< "True" if generator statistics are collected.
+	CBiteGenStats GenStats; ///< Solution generator statistics, shared by
+		///< all optimization objects.
+	CBiteTracer* Tracer; ///< Timeline tracer, NULL if not in use.
+	CBiteParetoArchive ParetoArchive; ///< Pareto archive, shared by all
+		///< optimization objects in multi-objective mode.
+	int ParetoSize; ///< Pareto archive's capacity.
+	CBiteOptMaskAdapter MaskAdapter; ///< Parameter mask adapter, owner of
+		///< the optimization objects.
+	double* MaskBuf; ///< Compact parameter vector buffer.
+	double* BestBuf; ///< Best parameter vector buffer, if masked.
+	double* LastBuf; ///< Latest parameter vector buffer, if masked.
+	int* ParamTypes; ///< Parameter types, NULL if all parameters are
+		///< continuous.
+	int* OptParamTypes; ///< Types of active parameters, assigned to
+		///< optimization objects.
+
 	/**
-	 * A short-cut solution generator. Parameter value short-cuts: they
-	 * considerably reduce convergence time for some functions while not
-	 * severely impacting performance for other functions.
-	 *
-	 * Can use variation with randomization between two values, and a slight
-	 * move towards real 0.
+	 * Function updates the Pareto archive's dimensions, and assigns the
+	 * archive to optimization objects, in multi-objective mode.
 	 */
 
-	void generateSol6( CBiteRnd& rnd )
+	void applyParetoArchive()
 	{
-		ptype* const Params = TmpParams;
-
-		const double r = rnd.getPow( 4.0 );
-		const int si = (int) ( r * CurPopSize );
-
-		double v[ 2 ];
-		v[ 0 ] = getRealValue( getParamsOrdered( si ),
-			rnd.getInt( ParamCount ));
-
-		if( rnd.getBit() )
-		{
-			v[ 1 ] = getRealValue( getParamsOrdered( si ),
-				rnd.getInt( ParamCount ));
-		}
-		else
+		if( ObjCount > 1 )
 		{
-			v[ 1 ] = v[ 0 ];
+			ParetoArchive.updateDims( ParamCount, ObjCount, ParetoSize );
 		}
 
-		const double m = 1.0 - r * r;
-		v[ 0 ] *= m; // Move towards real 0, useful for some functions.
-		v[ 1 ] *= m;
-
 		int i;
 
-		for( i = 0; i < ParamCount; i++ )
+		for( i = 0; i < OptCount; i++ )
 		{
-			Params[ i ] = (ptype) (( v[ rnd.getBit() ] - MinValues[ i ]) *
-				DiffValuesI[ i ]);
+			Opts[ i ] -> setParetoArchive( ObjCount > 1 ?
+				&ParetoArchive : NULL );
 		}
 	}
 
 	/**
-	 * A solution generator that randomly combines solutions from the main
-	 * and "old" populations. Conceptually, it can be called a
-	 * weighted-random crossover that combines solutions from diverse
-	 * sources.
+	 * Function assigns types of active parameters to optimization objects.
 	 */
 
-	void generateSol7( CBiteRnd& rnd )
+	void applyParamTypes()
 	{
-		ptype* const Params = TmpParams;
-
-		const CBitePop& OldPop = OldPops[ 1 ];
-		const int OldPopPos = OldPop.getCurPopPos();
-
-		static const double p[ 4 ] = { 1.5, 1.75, 2.0, 2.25 };
-		const double pwr = p[ select( Gen7PowFacSel, rnd )];
-		int i;
-
-		if( OldPopPos < 3 )
+		if( ParamTypes != NULL )
 		{
-			for( i = 0; i < ParamCount; i++ )
+			const int* const ai = MaskAdapter.getActiveIdx();
+			int i;
+
+			for( i = 0; i < MaskAdapter.getActiveCount(); i++ )
 			{
-				Params[ i ] = getParamsOrdered(
-					rnd.getPowInt( pwr, CurPopSize ))[ i ];
+				OptParamTypes[ i ] = ParamTypes[ ai[ i ]];
 			}
 		}
-		else
+
+		int i;
+
+		for( i = 0; i < OptCount; i++ )
 		{
-			for( i = 0; i < ParamCount; i++ )
-			{
-				if( rnd.getBit() && rnd.getBit() )
-				{
-					Params[ i ] = OldPop.getParamsOrdered(
-						rnd.getPowInt( pwr, OldPopPos ))[ i ];
-				}
-				else
-				{
-					Params[ i ] = getParamsOrdered(
-						rnd.getPowInt( pwr, CurPopSize ))[ i ];
-				}
-			}
+			Opts[ i ] -> setParamTypes( ParamTypes != NULL ?
+				OptParamTypes : NULL );
 		}
 	}
 
 	/**
-	 * Solution generator that is DE-alike in its base. It calculates a
-	 * centroid of a number of best solutions, and then applies "mutation"
-	 * operation between the centroid and the solutions, using a random
-	 * multiplier. This generator is similar to the "move" operation of
-	 * generator 1.
+	 * Function updates the evaluation cache's dimensions, and assigns the
+	 * cache to optimization objects.
 	 */
 
-	void generateSol8( CBiteRnd& rnd )
+	void applyEvalCache()
 	{
-		ptype* const Params = TmpParams;
-
-		const int Mode = select( Gen8ModeSel, rnd );
-		const int NumSols = 5 + select( Gen8NumSel, rnd );
-		const ptype* rp[ 8 ];
+		EvalCache.updateDims( MaskAdapter.getActiveCount(), EvalCacheSize );
 
-		// Calculate centroid of a number of selected solutions.
+		int i;
 
-		const ptype* rp0 = getParamsOrdered( rnd.getSqrInt( CurPopSize ));
-		rp[ 0 ] = rp0;
-		copyParams( Params, rp0 );
+		for( i = 0; i < OptCount; i++ )
+		{
+			Opts[ i ] -> setEvalCache( EvalCacheSize > 0 ? &EvalCache : NULL );
+		}
+	}
 
-		int j;
-		int i;
+	/**
+	 * Function deletes previously allocated buffers.
+	 */
 
-		for( j = 1; j < NumSols; j++ )
+	void deleteBuffers()
+	{
+		if( Opts != NULL )
 		{
-			rp0 = getParamsOrdered( rnd.getSqrInt( CurPopSize ));
-			rp[ j ] = rp0;
+			int i;
 
-			for( i = 0; i < ParamCount; i++ )
+			for( i = 0; i < OptCount; i++ )
 			{
-				Params[ i ] += rp0[ i ];
+				delete Opts[ i ];
 			}
+
+			delete[] Opts;
+			Opts = NULL;
 		}
 
-		const double m = 1.0 / NumSols;
+		delete[] MaskBuf;
+		delete[] BestBuf;
+		delete[] LastBuf;
+		delete[] ParamTypes;
+		delete[] OptParamTypes;
+		MaskBuf = NULL;
+		BestBuf = NULL;
+		LastBuf = NULL;
+		ParamTypes = NULL;
+		OptParamTypes = NULL;
+	}
+};
 
-		for( i = 0; i < ParamCount; i++ )
-		{
-			NewValues[ i ] = Params[ i ] * m; // Centroid.
-			Params[ i ] = (ptype) NewValues[ i ];
-		}
+/**
+ * Objective function.
+ */
 
-		// Apply "move" operations in one of two modes.
+typedef double( *biteopt_func )( int N, const double* x, void* func_data );
 
-		if( Mode == 0 )
-		{
-			static const double Spans[ 4 ] = { 1.5, 2.5, 3.5, 4.5 };
-			const double gm = Spans[ select( Gen8SpanSel[ Mode ], rnd )] *
-				sqrt( m );
+/**
+ * Objective function with the cost upper bound. The "bound" is the cost
+ * above which the solution is rejected (1e300 if there is no bound), see
+ * CBiteOptInterface::getCostBound(). The function may stop its calculation
+ * as soon as the cost exceeds the bound, and return any value above the
+ * bound, like the partial cost.
+ */
 
-			for( j = 0; j < NumSols; j++ )
-			{
-				const double r = rnd.getGaussian() * gm;
-				rp0 = rp[ j ];
+typedef double( *biteopt_func_b )( int N, const double* x, void* func_data,
+	double bound );
 
-				for( i = 0; i < ParamCount; i++ )
-				{
-					Params[ i ] += (ptype) (( NewValues[ i ] - rp0[ i ]) * r );
-				}
-			}
-		}
-		else
-		{
-			static const double Spans[ 4 ] = { 0.5, 1.5, 2.5, 3.5 };
-			const double gm = Spans[ select( Gen8SpanSel[ Mode ], rnd )];
+/**
+ * Delta-evaluation objective function. If "nc" >= 0, "x" differs from the
+ * already evaluated parent solution "px" with cost "pf" only in "nc"
+ * parameters listed in "ci", see CBiteOptInterface::getDeltaParent(). If
+ * "nc" < 0, "px" and "ci" are NULL, and the full evaluation is required.
+ */
 
-			for( j = 0; j < NumSols; j++ )
-			{
-				const double r = rnd.getGaussian() * gm;
-				rp0 = rp[ j ];
+typedef double( *biteopt_func_d )( int N, const double* x, const double* px,
+	double pf, int nc, const int* ci, void* func_data );
 
-				for( i = 0; i < ParamCount; i++ )
-				{
-					Params[ i ] += (ptype) (( Params[ i ] - rp0[ i ]) * r );
-				}
-			}
-		}
-	}
+/**
+ * Constraint function, should fill the "c" array with "NC" constraint
+ * values. A constraint is satisfied if its value is less or equal to 0.
+ */
 
-	/**
-	 * A "water drain" solution generator: makes a fixed-multiplier step from
-	 * a better random solution 1 towards or away from worse random solution
-	 * 2. Moderately efficient on its own.
-	 */
+typedef void( *biteopt_cns )( int N, const double* x, double* c,
+	void* func_data );
 
-	void generateSol9( CBiteRnd& rnd )
-	{
-		ptype* const Params = TmpParams;
+/**
+ * Multi-objective function, should fill the "f" array with "NO" objective
+ * values, which are minimized.
+ */
 
-		const ptype* const rp1 = getParamsOrdered(
-			rnd.getInt( CurPopSize ));
+typedef void( *biteopt_func_m )( int N, const double* x, double* f,
+	void* func_data );
 
-		const ptype* const rp2 = getParamsOrdered(
-			rnd.getSqrIntInv( CurPopSize ));
+/**
+ * Progress function, called periodically during minimization with the best
+ * solution found so far and its cost, the number of objective function
+ * evaluations performed, and the number of iterations without improvement.
+ * Returning "true" stops the minimization; the best solution found so far
+ * is then returned.
+ */
 
-		int i;
+typedef bool( *biteopt_progress )( int N, const double* x, double f,
+	int64_t nfev, int64_t stall, void* func_data );
 
-		// Such overall sign inversion seems unuseful, but has benefits in
-		// practice.
+/**
+ * Wrapper class for the biteopt_minimize() function. Can be used directly,
+ * to access options and statistics not available via biteopt_minimize().
+ */
 
-		if( rnd.getBit() )
-		{
-			for( i = 0; i < ParamCount; i++ )
-			{
-				Params[ i ] = rp1[ i ] - (( rp2[ i ] - rp1[ i ]) >> 1 ) *
-					( 1 - 2 * rnd.getBit() );
-			}
-		}
-		else
-		{
-			for( i = 0; i < ParamCount; i++ )
-			{
-				Params[ i ] = rp1[ i ] + (( rp2[ i ] - rp1[ i ]) >> 1 ) *
-					( 1 - 2 * rnd.getBit() );
-			}
-		}
+class CBiteOptMinimize : public CBiteOptDeep
+{
+public:
+	int N; ///< The number of dimensions in objective function.
+	biteopt_func f; ///< Objective function.
+	biteopt_func_b fb; ///< Objective function with the cost upper bound,
+		///< used instead of "f", if not NULL.
+	biteopt_func_d fd; ///< Delta-evaluation objective function, used
+		///< instead of "f" and "fb", if not NULL.
+	int NC; ///< The number of constraints, used if "fc" is not NULL.
+	biteopt_cns fc; ///< Constraint function, evaluated before the objective
+		///< function, NULL if not in use. Shares "data" with the objective
+		///< function. The best cost is 1e200 or higher if no feasible
+		///< solution was found.
+	int NO; ///< The number of objectives, used if "fm" is not NULL.
+	biteopt_func_m fm; ///< Multi-objective function, used instead of all
+		///< other objective functions, if not NULL. The Pareto front is
+		///< then available via getParetoArchive(), and the "minf" value of
+		///< minimize() is the best solution's rank. The persistent store is
+		///< not used in this mode.
+	biteopt_progress fp; ///< Progress function, NULL if not in use. Shares
+		///< "data" with the objective function. Called after every
+		///< ProgressEvals evaluations, or once ProgressTime has passed since
+		///< its previous call, whichever comes first. The "x" pointer is
+		///< only valid during the call.
+	int64_t ProgressEvals; ///< Evaluation interval of "fp" calls, 0 to
+		///< disable.
+	double ProgressTime; ///< Time interval of "fp" calls, in seconds, 0 to
+		///< disable.
+	double MaxTime; ///< Wall-clock time budget of minimize(), in seconds, 0
+		///< if unlimited. When it runs out, the best solution found so far
+		///< is returned.
+	bool FastRnd; ///< "True" if the buffered multi-lane PRNG mode should be
+		///< used, see CBiteRnd; it produces a different sequence than the
+		///< default (legacy) mode. Ignored if "rf" is passed to minimize().
+	void* data; ///< Objective function's data.
+	const double* lb; ///< Parameters' lower bounds.
+	const double* ub; ///< Parameters' upper bounds.
+	const int* types; ///< Parameter types (see
+		///< CBiteOptInterface::EParamType), NULL if all parameters are
+		///< continuous. Integer and categorical parameters are passed to
+		///< objective functions as integer values, and duplicate solutions
+		///< are not evaluated, see CBiteOpt::setParamTypes().
+	double ftol; ///< Relative cost spread of the population, at which an
+		///< attempt is stopped; 0 if not in use. See
+		///< CBiteOptDeep::isConverged(). Ignored in multi-objective mode.
+	double xtol; ///< Parameter spread of the population, relative to
+		///< parameter ranges, at which an attempt is stopped; 0 if not in
+		///< use. Both criteria should be met, if both are in use.
+	CBiteStore* Store; ///< Persistent evaluation store, checked before
+		///< objective function evaluation; NULL if not in use. Should be
+		///< opened with the same "N", "lb" and "ub".
+	CBiteEvalLog* EvalLog; ///< Evaluation log, receives all objective
+		///< function evaluations, except those served from the persistent
+		///< store; NULL if not in use. Should be opened with the same "N".
+		///< Not used in multi-objective mode.
+
+	int64_t BoundExceedCount; ///< The number of "fb" function calls that
+		///< returned a value above the bound, during the latest minimize()
+		///< call.
+
+	int64_t DeltaEvalCount; ///< The number of "fd" function calls with the
+		///< parent solution, during the latest minimize() call.
+
+	int64_t PolishIter; ///< The maximal number of objective function
+		///< evaluations of the local polishing phase, performed by
+		///< minimize() after all attempts, 0 to disable polishing. The
+		///< phase uses the CNMSeqOpt optimizer, started from the best
+		///< solution found. Not performed in multi-objective mode, and if
+		///< the "f_minp" stopping value was reached.
+	double PolishRadius; ///< Initial radius of the polishing phase,
+		///< relative to the default CNMSeqOpt radius (0.25 of parameter
+		///< ranges); 0 to derive it from the final parameter spread of the
+		///< population that produced the best solution, see
+		///< CBitePop::calcParamSpread().
+	int64_t PolishStall; ///< The number of polishing evaluations without best
+		///< cost improvement, at which polishing is stopped; 0 to use
+		///< 128 * N.
+	int64_t PolishEvalCount; ///< The number of objective function evaluations
+		///< performed by the polishing phase of the latest minimize()
+		///< call. Included into minimize()'s return value.
+	int64_t FuncCallCount; ///< The number of objective function calls
+		///< ("f", "fb", "fd" or "fm") during the latest minimize() call.
+		///< Unlike minimize()'s return value, excludes evaluations served
+		///< from the evaluation cache or the persistent store.
+	bool IsProgressStop; ///< "True" if the latest minimize() call was
+		///< stopped by the progress function "fp".
+	bool IsTimeStop; ///< "True" if the latest minimize() call was stopped
+		///< due to MaxTime.
+
+	CBiteOptMinimize()
+		: fb( NULL )
+		, fd( NULL )
+		, NC( 0 )
+		, fc( NULL )
+		, NO( 1 )
+		, fm( NULL )
+		, fp( NULL )
+		, ProgressEvals( 0 )
+		, ProgressTime( 0.0 )
+		, MaxTime( 0.0 )
+		, FastRnd( false )
+		, types( NULL )
+		, ftol( 0.0 )
+		, xtol( 0.0 )
+		, Store( NULL )
+		, EvalLog( NULL )
+		, BoundExceedCount( 0 )
+		, DeltaEvalCount( 0 )
+		, PolishIter( 0 )
+		, PolishRadius( 0.0 )
+		, PolishStall( 0 )
+		, PolishEvalCount( 0 )
+		, FuncCallCount( 0 )
+		, IsProgressStop( false )
+		, IsTimeStop( false )
+		, PolishOpt( &MaskAdapter )
+		, IsPolishing( false )
+		, IsAborted( false )
+		, PolishCns( NULL )
+		, PolishBuf( NULL )
+		, DeltaBufN( 0 )
+		, DeltaValues( NULL )
+		, DeltaIdx( NULL )
+		, LogAttempt( 0 )
+		, ProgressNextEval( 0 )
+		, ProgressNextTime( 0 )
+		, ProgressBuf( NULL )
+		, TimeLimit( 0 )
+		, TimeCheckLast( 0 )
+		, TimeCheckTicks( 0 )
+		, TimeCheckOrigin( 0 )
+		, TimeCheckOriginTicks( 0 )
+		, TimeCheckSlowTicks( 0 )
+		, TimeCheckStep( 1 )
+		, TimeCheckLeft( 1 )
+		, UseClock( false )
+	{
 	}
 
-	/**
-	 * Solution generator based on SpherOpt's converging hyper-spheroid.
-	 */
+	virtual ~CBiteOptMinimize()
+	{
+		delete[] PolishCns;
+		delete[] PolishBuf;
+		delete[] ProgressBuf;
+		delete[] DeltaValues;
+		delete[] DeltaIdx;
+	}
 
-	void generateSol10( CBiteRnd& rnd )
+	virtual void getMinValues( double* const p ) const
 	{
-		ptype* const Params = TmpParams;
+		memcpy( p, lb, N * sizeof( p[ 0 ]));
+	}
 
-		const ptype* const rp1 = getParamsOrdered(
-			rnd.getSqrInt( CurPopSize ));
+	virtual void getMaxValues( double* const p ) const
+	{
+		memcpy( p, ub, N * sizeof( p[ 0 ]));
+	}
 
-		const ptype* const rp2 = getParamsOrdered(
-			rnd.getSqrIntInv( CurPopSize ));
+	virtual void optcns( const double* const p, double* const c )
+	{
+		( *fc )( N, p, c, data );
+	}
 
-		int i;
+	virtual void optobjs( const double* const p, double* const objs )
+	{
+		FuncCallCount++;
+		( *fm )( N, p, objs, data );
+	}
 
-		// Calculate centroid.
+	virtual bool isCostBoundUsed() const
+	{
+		return( fb != NULL );
+	}
 
-		for( i = 0; i < ParamCount; i++ )
+	virtual double optrank( const double* p )
+	{
+		if( IsPolishing && types != NULL )
 		{
-			Params[ i ] = ( rp1[ i ] + rp2[ i ]) >> 1;
-		}
-
-		// Calculate radius.
+			// CNMSeqOpt does not snap discrete parameters itself.
 
-		double Radius = 0.0;
+			snapValues( p, PolishBuf );
+			p = PolishBuf;
+		}
 
-		for( i = 0; i < ParamCount; i++ )
+		if( IsPolishing && fc != NULL )
 		{
-			const ptype v1 = rp1[ i ] - Params[ i ];
-			const ptype v2 = rp2[ i ] - Params[ i ];
-			Radius += (double) v1 * v1 + 0.45 * v2 * v2;
-		}
+			// CNMSeqOpt does not evaluate constraints itself.
 
-		// Select a point on a hyper-spheroid.
+			optcns( p, PolishCns );
 
-		double s2 = 1e-300;
+			const double r = CBiteOptBase< double > :: calcCnsRank(
+				PolishCns, NC );
 
-		for( i = 0; i < ParamCount; i++ )
+			if( r > 0.0 )
+			{
+				return( r );
+			}
+		}
+
+		if( IsPolishing && Tracer != NULL )
 		{
-			NewValues[ i ] = rnd.get() - 0.5;
-			s2 += NewValues[ i ] * NewValues[ i ];
+			const int64_t tt0 = CBiteTracer :: getTimestamp();
+			const double c = optcost( p );
+			Tracer -> addSpan( "eval", tt0 );
+
+			return( c );
 		}
 
-		// Add hyper-spheroid-based offset to the centroid.
+		return( optcost( p ));
+	}
 
-		const double d = sqrt( Radius / s2 );
+	virtual double optcost( const double* const p )
+	{
+		double c;
 
-		for( i = 0; i < ParamCount; i++ )
+		if( Store != NULL && Store -> find( p, c ))
 		{
-			Params[ i ] += (ptype) ( NewValues[ i ] * d );
+			return( c );
 		}
-	}
 
-	/**
-	 * Stochastic PSO-alike solution generator. Moves a randomly-selected
-	 * existing solution towards a better solution, and at the same times
-	 * makes a move in a random direction having a magnitude derived as a
-	 * distance between a better and worse solutions (limits the magnitude to
-	 * the current basin of solutions).
-	 */
+		FuncCallCount++;
 
-	void generateSol11( CBiteRnd& rnd )
-	{
-		ptype* const Params = TmpParams;
+		if( fd != NULL )
+		{
+			if( DeltaBufN != N )
+			{
+				delete[] DeltaValues;
+				delete[] DeltaIdx;
+				DeltaBufN = N;
+				DeltaValues = new double[ N ];
+				DeltaIdx = new int[ N ];
+			}
 
-		const ptype* const rp0 = getParamsOrdered(
-			rnd.getInt( CurPopSize ));
+			double pf;
+			const int nc = getDeltaParent( DeltaValues, &pf, DeltaIdx );
 
-		const ptype* const rp1 = getParamsOrdered(
-			rnd.getPowInt( 4.0, CurPopSize ));
+			if( nc < 0 )
+			{
+				c = ( *fd )( N, p, NULL, 0.0, -1, NULL, data );
+			}
+			else
+			{
+				DeltaEvalCount++;
+				c = ( *fd )( N, p, DeltaValues, pf, nc, DeltaIdx, data );
+			}
+		}
+		else
+		if( fb != NULL )
+		{
+			const double b = getCostBound();
+			c = ( *fb )( N, p, data, b );
 
-		const ptype* const rp2 = getParamsOrdered(
-			rnd.getSqrIntInv( CurPopSize ));
+			if( c > b )
+			{
+				// Partial cost, should not be stored; return the same value
+				// as for NaN cost.
 
-		double s1 = 1e-300;
-		double s2 = 1e-300;
-		double d;
-		int i;
+				BoundExceedCount++;
+				logEval( p, 1e300 );
 
-		for( i = 0; i < ParamCount; i++ )
+				return( 1e300 );
+			}
+		}
+		else
 		{
-			d = (double) ( rp1[ i ] - rp2[ i ]);
-			s1 += d * d;
-
-			NewValues[ i ] = rnd.get() - 0.5;
-			s2 += NewValues[ i ] * NewValues[ i ];
+			c = ( *f )( N, p, data );
 		}
 
-		const double m1 = sqrt( ParamCountI ) * 0.5;
-		const double m0 = 1.0 - m1;
-		d = sqrt( s1 * ParamCountI / s2 ) * 2.0;
+		if( IsAborted )
+		{
+			return( c );
+		}
 
-		for( i = 0; i < ParamCount; i++ )
+		if( Store != NULL )
 		{
-			Params[ i ] = (ptype) ( rp0[ i ] * m0 + rp1[ i ] * m1 +
-				NewValues[ i ] * d );
+			Store -> insert( p, c );
 		}
+
+		logEval( p, c );
+
+		return( c );
 	}
 
 	/**
-	 * Solution generator that estimates population's standard deviation using
-	 * better and worse solutions, and then generates a solution using
-	 * Gaussian sampling around centroid.
+	 * Function requests the minimize() function to stop after the current
+	 * objective function evaluation, and to return the best solution found
+	 * so far. Meant to be called by the objective, constraint or progress
+	 * function, e.g. on an error; the function's value is then ignored, and
+	 * is neither stored nor logged. Further evaluations of the current
+	 * iteration, if any, should return without doing any work.
 	 */
 
-	void generateSol12( CBiteRnd& rnd )
+	void abort()
 	{
-		ptype* const Params = TmpParams;
-
-		const ptype* const rp1 = getParamsOrdered(
-			rnd.getSqrInt( CurPopSize ));
-
-		const ptype* const rp2 = getParamsOrdered(
-			rnd.getSqrIntInv( CurPopSize ));
-
-		const ptype* const rpc = getCentroid();
-		double r = 0.0;
-		int i;
-
-		for( i = 0; i < ParamCount; i++ )
-		{
-			const double d1 = (double) ( rp2[ i ] - rp1[ i ]);
-			r += d1 * d1;
-		}
+		IsAborted = true;
+	}
 
-		r = sqrt( r / ParamCount );
+	/**
+	 * @return "True" if the abort() function was called during the latest
+	 * minimize() call.
+	 */
 
-		for( i = 0; i < ParamCount; i++ )
-		{
-			Params[ i ] = rpc[ i ] + (ptype) ( rnd.getGaussian() * r );
-		}
+	bool isAborted() const
+	{
+		return( IsAborted );
 	}
 
 	/**
-	 * Solution generator that applies Differential Evolution in real
-	 * parameter value space, in a randomized fashion: each parameter value
-	 * receives a DE operation value of a randomly-chosen parameter. This
-	 * solution generator is moderately effective even on its own.
+	 * Function performs minimization, see the biteopt_minimize() function
+	 * for the description of parameters. The "N", "f", "data", "lb" and "ub"
+	 * variables should be assigned before calling this function. If the
+	 * evaluation cache is enabled, the returned evaluation count includes
+	 * evaluations served from the cache, and evaluations of the polishing
+	 * phase (see PolishIter). The Pareto archive is cleared before
+	 * minimization.
 	 */
 
-	void generateSol13( CBiteRnd& rnd )
+	int64_t minimize( double* x, double* minf, const int64_t iter,
+		const int M = 1, const int attc = 10, const int stopc = 0,
+		biteopt_rng rf = 0, void* rdata = 0, double* f_minp = 0,
+		const uint64_t* seedp = 0 )
 	{
-		ptype* const Params = TmpParams;
+		TimeCheckLast = CBiteTracer :: getTimestamp();
+		TimeLimit = TimeCheckLast + (int64_t) ( MaxTime * 1e9 );
+		TimeCheckTicks = CBiteGenStats :: getTimestamp();
+		TimeCheckOrigin = TimeCheckLast;
+		TimeCheckOriginTicks = TimeCheckTicks;
+		TimeCheckSlowTicks = 0;
+		TimeCheckStep = 1;
+		TimeCheckLeft = 1;
+		IsTimeStop = false;
+		IsAborted = false;
 
-		const CBitePop& ParPop = selectParPop( 7, rnd );
-		const int ParPopSize = ParPop.getCurPopSize();
+		updateDims( N, M, 0, ( fc != NULL ? NC : 0 ),
+			( fm != NULL ? NO : 1 ));
 
-		const ptype* const rp1 = getParamsOrdered(
-			rnd.getSqrInt( CurPopSize ));
+		setParamTypes( types );
 
-		const int kc = 4;
-		const ptype* rp2[ kc ];
-		const ptype* rp3[ kc ];
-		int i;
+		clearParetoArchive();
 
-		for( i = 0; i < kc; i++ )
+		if( EvalLog != NULL )
 		{
-			rp2[ i ] = ParPop.getParamsOrdered(
-				rnd.getLogInt( ParPopSize ));
-
-			rp3[ i ] = ParPop.getParamsOrdered( ParPopSize - 1 -
-				rnd.getLogInt( ParPopSize ));
+			EvalLog -> setPopSize( Opts[ 0 ] -> getPopSize() );
 		}
 
-		for( i = 0; i < ParamCount; i++ )
+		CBiteRnd rnd;
+		rnd.init( 1, rf, rdata, FastRnd );
+
+		const int64_t sct = ( stopc <= 0 ? 0 : (int64_t) 128 * N * stopc );
+		const int64_t useiter = (int64_t) ( iter * sqrt( (double) M ));
+		const bool DoTolCheck = ( xtol > 0.0 ||
+			( ftol > 0.0 && fm == NULL ));
+		bool IsFinished = false;
+		double xspread = 0.0; // Parameter spread of the population of "x".
+		int64_t evals = 0;
+		int k;
+
+		PolishEvalCount = 0;
+		FuncCallCount = 0;
+		BoundExceedCount = 0;
+		DeltaEvalCount = 0;
+		IsProgressStop = false;
+		UseClock = ( MaxTime > 0.0 || ( fp != NULL && ProgressTime > 0.0 ));
+		ProgressNextEval = ProgressEvals;
+		ProgressNextTime = CBiteTracer :: getTimestamp() +
+			(int64_t) ( ProgressTime * 1e9 );
+
+		for( k = 0; k < attc; k++ )
 		{
-			const int j = rnd.getInt( ParamCount );
-			const int k = rnd.getInt( kc );
+			if( seedp != 0 && rf == 0 )
+			{
+				rnd.initStream( *seedp, (uint64_t) k, FastRnd );
+			}
 
-			Params[ i ] = (ptype) (( getRealValue( rp1, i ) +
-				( getRealValue( rp2[ k ], j ) -
-				getRealValue( rp3[ k ], j )) * 0.5 - MinValues[ i ]) *
-				DiffValuesI[ i ]);
-		}
-	}
+			init( rnd );
+			LogAttempt = k;
 
-	/**
-	 * Solution generator that obtains solution from an independently-running
-	 * parallel optimizer.
-	 */
+			const int64_t tt0 = ( Tracer != NULL ?
+				CBiteTracer :: getTimestamp() : 0 );
 
-	void generateSolPar( CBiteRnd& rnd )
-	{
-		DoEval = false;
-		CBitePop* UpdPop;
+			int tc = 0; // Iterations since the last population collapse check.
+			int64_t i;
 
-		if( UseParOpt == 1 )
-		{
-			// Re-assign optimizer 2 based on comparison of its
-			// efficiency with optimizer 1.
+			for( i = 0; i < useiter; i++ )
+			{
+				const int64_t sc = optimize( rnd );
 
-			UseParOpt = select( ParOpt2Sel, rnd );
-		}
+				if( IsAborted )
+				{
+					evals++;
+					IsFinished = true;
+					break;
+				}
 
-		if( UseParOpt == 0 )
-		{
-			const int sc = ParOpt.optimize( rnd );
+				if( f_minp != 0 && getBestCost() <= *f_minp )
+				{
+					evals++;
+					IsFinished = true;
+					break;
+				}
 
-			LastCosts = ParOpt.getLastCosts();
-			LastValues = ParOpt.getLastValues();
+				if( sct > 0 && sc >= sct )
+				{
+					evals++;
+					break;
+				}
 
-			if( sc != 0 )
-			{
-				UseParOpt = 1; // On stall, select optimizer 2.
+				const bool cr = ( UseClock && readClock() );
 
-				if( sc > ParamCount * 64 )
+				if( cr && isTimeOut() )
 				{
-					ParOpt.init( rnd, getBestParams(), StartSD * 2.0 );
-					ParOptPop.resetCurPopPos();
+					evals++;
+					IsFinished = true;
+					break;
 				}
-			}
 
-			UpdPop = &ParOptPop;
-		}
-		else
-		{
-			const int sc = ParOpt2.optimize( rnd );
+				if( fp != NULL && isProgressDue( evals + i + 1, cr ))
+				{
+					const double* bx = getBestParams();
+					double bc = getBestCost();
 
-			LastCosts = ParOpt2.getLastCosts();
-			LastValues = ParOpt2.getLastValues();
+					if( k > 0 && *minf < bc )
+					{
+						bx = x;
+						bc = *minf;
+					}
 
-			if( sc != 0 )
-			{
-				UseParOpt = 0; // On stall, select optimizer 1.
+					if( callProgress( bx, bc, evals + i + 1, sc ))
+					{
+						evals++;
+						IsFinished = true;
+						break;
+					}
+				}
 
-				if( sc > ParamCount * 128 )
+				if( DoTolCheck )
 				{
-					ParOpt2.init( rnd, getBestParams(), StartSD * 4.0 );
-					ParOpt2Pop.resetCurPopPos();
+					// Check population collapse once per population
+					// turnover; each iteration advances one of OptCount
+					// populations.
+
+					tc++;
+
+					if( tc >= OptCount * Opts[ 0 ] -> getCurPopSize() )
+					{
+						tc = 0;
+
+						if( isConverged( ftol, xtol ))
+						{
+							evals++;
+							break;
+						}
+					}
 				}
 			}
 
-			UpdPop = &ParOpt2Pop;
-		}
-
-		int i;
+			evals += i;
 
-		for( i = 0; i < ParamCount; i++ )
-		{
-			TmpParams[ i ] = (ptype) (( LastValues[ i ] - MinValues[ i ]) *
-				DiffValuesI[ i ]);
-		}
+			if( Tracer != NULL )
+			{
+				Tracer -> addSpan( "attempt", tt0 );
+			}
 
-		UpdPop -> updatePop( LastCosts[ 0 ], TmpParams, false );
-	}
-};
+			if( k == 0 || getBestCost() <= *minf )
+			{
+				memcpy( x, getBestParams(), N * sizeof( x[ 0 ]));
+				*minf = getBestCost();
 
-/**
- * Deep optimization class. Based on an array of M CBiteOpt objects. This
- * "deep" method pushes the newly-obtained solution to the next CBiteOpt
- * object which is then optimized.
- *
- * Description is available at https://github.com/avaneev/biteopt
- */
+				if( PolishIter > 0 && PolishRadius <= 0.0 )
+				{
+					xspread = BestOpt -> calcParamSpread();
+				}
+			}
 
-class CBiteOptDeep : public CBiteOptInterface
-{
-public:
-	CBiteOptDeep()
-		: ParamCount( 0 )
-		, OptCount( 0 )
-		, Opts( NULL )
-	{
-	}
+			if( IsFinished )
+			{
+				break;
+			}
+		}
 
-	virtual ~CBiteOptDeep()
-	{
-		deleteBuffers();
-	}
+		if( PolishIter > 0 && fm == NULL && !IsFinished )
+		{
+			const int64_t tt0 = ( Tracer != NULL ?
+				CBiteTracer :: getTimestamp() : 0 );
 
-	virtual const double* getBestParams() const
-	{
-		return( BestOpt -> getBestParams() );
-	}
+			PolishEvalCount = polish( rnd, x, minf, xspread, f_minp,
+				evals );
+			evals += PolishEvalCount;
 
-	virtual double getBestCost() const
-	{
-		return( BestOpt -> getBestCost() );
-	}
+			if( Tracer != NULL )
+			{
+				Tracer -> addSpan( "polish", tt0 );
+			}
+		}
 
-	virtual const double* getLastCosts() const
-	{
-		return( LastOpt -> getLastCosts() );
+		return( evals );
 	}
 
-	virtual const double* getLastValues() const
-	{
-		return( LastOpt -> getLastValues() );
-	}
+protected:
+	CBiteOptOwned< CNMSeqOpt > PolishOpt; ///< Polishing phase optimizer.
+	bool IsPolishing; ///< "True" during the polishing phase.
+	bool IsAborted; ///< "True" if abort() was called.
+	double* PolishCns; ///< Constraint values buffer, for the polishing
+		///< phase.
+	double* PolishBuf; ///< Snapped parameter vector buffer, for the
+		///< polishing phase.
+	int DeltaBufN; ///< The length of delta-evaluation buffers.
+	double* DeltaValues; ///< Parent's values buffer, for the "fd" function.
+	int* DeltaIdx; ///< Changed parameter indices buffer, for the "fd"
+		///< function.
+	int LogAttempt; ///< Attempt index, for the evaluation log.
+	int64_t ProgressNextEval; ///< Evaluation count of the next "fp" call.
+	int64_t ProgressNextTime; ///< Timestamp of the next "fp" call, see
+		///< CBiteTracer::getTimestamp().
+	double* ProgressBuf; ///< Best solution buffer, for "fp" calls during
+		///< the polishing phase.
+	int64_t TimeLimit; ///< Timestamp at which MaxTime runs out, see
+		///< CBiteTracer::getTimestamp().
+	int64_t TimeCheckLast; ///< Timestamp of the latest time check.
+	int64_t TimeCheckTicks; ///< Timestamp of the latest readClock() call,
+		///< see CBiteGenStats::getTimestamp(). Used with BITEOPT_RDTSC.
+	int64_t TimeCheckOrigin; ///< Timestamp of the minimize() call's start.
+	int64_t TimeCheckOriginTicks; ///< TimeCheckOrigin, in the
+		///< CBiteGenStats::getTimestamp() units.
+	int64_t TimeCheckSlowTicks; ///< The number of ticks in 1 millisecond,
+		///< measured on clock reads; 0 if not yet measured.
+	int TimeCheckStep; ///< The number of readClock() calls between clock
+		///< reads.
+	int TimeCheckLeft; ///< The number of readClock() calls left until the
+		///< next clock read.
+	bool UseClock; ///< "True" if readClock() should be called, for MaxTime
+		///< or ProgressTime.
 
 	/**
-	 * Function returns a pointer to an array of selectors in use by the
-	 * current CBiteOpt object.
+	 * Function reads the clock into TimeCheckLast once per TimeCheckStep
+	 * calls, for the isTimeOut() and isProgressDue() functions; should be
+	 * called once per iteration. The step is doubled while reads are less
+	 * than 1 millisecond apart, and is reset to 1 otherwise. With MaxTime,
+	 * the step is also limited so that the projected interval between reads
+	 * stays within a quarter of the remaining time.
+	 *
+	 * With BITEOPT_RDTSC, each call also reads the tick counter, and reads
+	 * the clock right away after an iteration longer than 1 millisecond, so
+	 * that a sudden increase of the evaluation time delays a time check by
+	 * one iteration at most.
+	 *
+	 * @return "True" if the clock was read.
 	 */
 
-	CBiteSelBase** getSels()
+	bool readClock()
 	{
-		return( CurOpt -> getSels() );
+	#if defined( BITEOPT_RDTSC )
+		const int64_t tk = CBiteGenStats :: getTimestamp();
+		const bool IsSlow = ( TimeCheckSlowTicks > 0 &&
+			tk - TimeCheckTicks >= TimeCheckSlowTicks );
+
+		TimeCheckTicks = tk;
+	#else // defined( BITEOPT_RDTSC )
+		const bool IsSlow = false;
+	#endif // defined( BITEOPT_RDTSC )
+
+		TimeCheckLeft--;
+
+		if( TimeCheckLeft > 0 && !IsSlow )
+		{
+			return( false );
+		}
+
+		const int64_t t = CBiteTracer :: getTimestamp();
+		const int64_t dt = t - TimeCheckLast;
+
+	#if defined( BITEOPT_RDTSC )
+		if( t - TimeCheckOrigin >= 1000000 )
+		{
+			TimeCheckSlowTicks = (int64_t) (( tk - TimeCheckOriginTicks ) *
+				1e6 / ( t - TimeCheckOrigin ));
+		}
+	#endif // defined( BITEOPT_RDTSC )
+
+		if( dt < 1000000 && !IsSlow )
+		{
+			const int64_t it = dt / TimeCheckStep + 1; // Iteration time.
+
+			TimeCheckStep = ( TimeCheckStep < 1024 ? TimeCheckStep * 2 :
+				TimeCheckStep );
+
+			if( MaxTime > 0.0 )
+			{
+				while( TimeCheckStep > 1 &&
+					it * TimeCheckStep * 4 > TimeLimit - t )
+				{
+					TimeCheckStep >>= 1;
+				}
+			}
+		}
+		else
+		{
+			TimeCheckStep = 1;
+		}
+
+		TimeCheckLast = t;
+		TimeCheckLeft = TimeCheckStep;
+
+		return( true );
 	}
 
 	/**
-	 * Function returns a pointer to an array of selector names.
+	 * Function checks whether MaxTime has run out, at the time of the latest
+	 * readClock() call.
+	 *
+	 * @return "True" if the time has run out; sets IsTimeStop.
 	 */
 
-	const char** getSelNames() const
+	bool isTimeOut()
 	{
-		return( CurOpt -> getSelNames() );
+		IsTimeStop = ( MaxTime > 0.0 && TimeCheckLast >= TimeLimit );
+
+		return( IsTimeStop );
 	}
 
 	/**
-	 * Function returns the number of selectors in use by the current CBiteOpt
-	 * object.
+	 * @return "True" if the progress function call is due.
+	 * @param nfev The number of evaluations performed.
+	 * @param IsClockRead "True" if the latest readClock() call read the
+	 * clock; ProgressTime is only checked then.
 	 */
 
-	int getSelCount() const
+	bool isProgressDue( const int64_t nfev, const bool IsClockRead ) const
 	{
-		return( CurOpt -> getSelCount() );
+		return(( ProgressEvals > 0 && nfev >= ProgressNextEval ) ||
+			( ProgressTime > 0.0 && IsClockRead &&
+			TimeCheckLast >= ProgressNextTime ));
 	}
 
 	/**
-	 * Function updates dimensionality of *this object. Function does nothing
-	 * if dimensionality has not changed since the last call. This function
-	 * should be called at least once before calling the init() function.
+	 * Function calls the progress function, and schedules its next call.
 	 *
-	 * @param aParamCount The number of parameters being optimized.
-	 * @param M The number of CBiteOpt objects. This number depends on the
-	 * complexity of the objective function, if the default value does not
-	 * produce a good solution, it should be increased together with the
-	 * iteration count. Minimal value is 1, in this case a plain CBiteOpt
-	 * optimization will be performed.
-	 * @param PopSize0 The number of elements in population to use. If set to
-	 * 0, the default formula will be used.
+	 * @param bx The best solution found so far.
+	 * @param bc The best solution's cost.
+	 * @param nfev The number of evaluations performed.
+	 * @param sc The number of iterations without improvement.
+	 * @return "True" if minimization should be stopped.
 	 */
 
-	void updateDims( const int aParamCount, const int M = 6,
-		const int PopSize0 = 0 )
+	bool callProgress( const double* const bx, const double bc,
+		const int64_t nfev, const int64_t sc )
 	{
-		if( aParamCount == ParamCount && M == OptCount )
-		{
-			return;
-		}
-
-		deleteBuffers();
+		IsProgressStop = ( *fp )( N, bx, bc, nfev, sc, data );
+		ProgressNextEval = nfev + ProgressEvals;
+		ProgressNextTime = CBiteTracer :: getTimestamp() +
+			(int64_t) ( ProgressTime * 1e9 );
 
-		ParamCount = aParamCount;
-		OptCount = M;
-		Opts = new CBiteOptOwned< CBiteOpt >*[ OptCount ];
+		return( IsProgressStop );
+	}
 
-		int i;
+	/**
+	 * Function adds an evaluated solution to the evaluation log, if it is
+	 * in use.
+	 *
+	 * @param p Parameter vector.
+	 * @param c Cost.
+	 */
 
-		for( i = 0; i < OptCount; i++ )
+	void logEval( const double* const p, const double c )
+	{
+		if( EvalLog != NULL )
 		{
-			Opts[ i ] = new CBiteOptOwned< CBiteOpt >( this );
-			Opts[ i ] -> updateDims( aParamCount, PopSize0 );
+			EvalLog -> add( p, c, ( IsPolishing ? CBiteEvalLog :: GenPolish :
+				getEvalGen() ), LogAttempt );
 		}
 	}
 
 	/**
-	 * Function initializes *this optimizer. Performs N=PopSize objective
-	 * function evaluations.
+	 * Function performs the local polishing phase, using the CNMSeqOpt
+	 * optimizer started from the specified solution.
 	 *
 	 * @param rnd Random number generator.
-	 * @param InitParams Initial parameter values.
-	 * @param InitRadius Initial radius, relative to the default value.
+	 * @param[in,out] x Solution to polish; replaced with the polished
+	 * solution, if it is better.
+	 * @param[in,out] minf Solution's cost.
+	 * @param xspread Parameter spread of the population that produced the
+	 * solution, see CBitePop::calcParamSpread(). Used if PolishRadius is 0.
+	 * @param f_minp If non-zero, a pointer to the stopping value.
+	 * @param evals0 The number of evaluations performed before polishing,
+	 * for progress function calls.
+	 * @return The number of objective function evaluations performed.
 	 */
 
-	void init( CBiteRnd& rnd, const double* const InitParams = NULL,
-		const double InitRadius = 1.0 )
+	int64_t polish( CBiteRnd& rnd, double* const x, double* const minf,
+		const double xspread, const double* const f_minp,
+		const int64_t evals0 )
 	{
-		int i;
+		double r = PolishRadius;
 
-		for( i = 0; i < OptCount; i++ )
+		if( r <= 0.0 )
 		{
-			Opts[ i ] -> init( rnd, InitParams, InitRadius );
+			r = 0.25 * xspread;
+			r = ( r < 1e-12 ? 1e-12 : ( r > 1.0 ? 1.0 : r ));
 		}
 
-		BestOpt = Opts[ 0 ];
-		CurOpt = Opts[ 0 ];
-		LastOpt = CurOpt;
-		StallCount = 0;
-
-		if( OptCount == 1 )
-		{
-			PushOpt = CurOpt;
-		}
-		else
-		{
-			while( true )
-			{
-				PushOpt = Opts[ rnd.getInt( OptCount )];
+		// Polishing is performed on active parameters only.
 
-				if( PushOpt != CurOpt )
-				{
-					break;
-				}
-			}
-		}
-	}
+		MaskAdapter.pack( x, MaskBuf );
 
-	/**
-	 * Function performs the parameter optimization iteration that involves 1
-	 * objective function evaluation.
-	 *
-	 * @param rnd Random number generator.
-	 * @return The number of non-improving iterations so far. The plateau
-	 * threshold value is ParamCount * 64.
-	 */
+		PolishOpt.updateDims( MaskAdapter.getActiveCount() );
+		PolishOpt.init( rnd, MaskBuf, r );
 
-	int optimize( CBiteRnd& rnd )
-	{
-		if( OptCount == 1 )
+		if( fc != NULL )
 		{
-			StallCount = Opts[ 0 ] -> optimize( rnd );
-
-			return( StallCount );
+			delete[] PolishCns;
+			PolishCns = new double[ NC ];
 		}
 
-		const int sc = CurOpt -> optimize( rnd, PushOpt );
-		LastOpt = CurOpt;
-
-		if( CurOpt -> getBestCost() <= BestOpt -> getBestCost() )
+		if( types != NULL )
 		{
-			BestOpt = CurOpt;
+			delete[] PolishBuf;
+			PolishBuf = new double[ N ];
 		}
 
-		if( sc == 0 )
+		if( fp != NULL )
 		{
-			StallCount = 0;
+			delete[] ProgressBuf;
+			ProgressBuf = new double[ N ];
 		}
-		else
+
+		const int64_t sct = ( PolishStall > 0 ? PolishStall :
+			(int64_t) 128 * MaskAdapter.getActiveCount() );
+		double pc = 1e300;
+		int64_t pi = 0; // Evaluation index of the latest improvement.
+		int64_t i;
+
+		IsPolishing = true;
+
+		for( i = 0; i < PolishIter; i++ )
 		{
-			StallCount++;
-			CurOpt = PushOpt;
+			PolishOpt.optimize( rnd );
 
-			if( OptCount == 2 )
+			if( IsAborted )
 			{
-				PushOpt = Opts[ CurOpt == Opts[ 0 ]];
+				i++;
+				break;
+			}
+
+			const double c = PolishOpt.getBestCost();
+
+			if( c < pc )
+			{
+				pc = c;
+				pi = i;
 			}
 			else
+			if( i - pi >= sct )
 			{
-				while( true )
+				i++;
+				break;
+			}
+
+			if( f_minp != 0 && c <= *f_minp )
+			{
+				i++;
+				break;
+			}
+
+			const bool cr = ( UseClock && readClock() );
+
+			if( cr && isTimeOut() )
+			{
+				i++;
+				break;
+			}
+
+			if( fp != NULL && isProgressDue( evals0 + i + 1, cr ))
+			{
+				const double* bx = x;
+				double bc = *minf;
+
+				if( c < bc )
 				{
-					PushOpt = Opts[ rnd.getInt( OptCount )];
+					MaskAdapter.unpack( PolishOpt.getBestParams(),
+						ProgressBuf );
 
-					if( PushOpt != CurOpt )
+					if( types != NULL )
 					{
-						break;
+						snapValues( ProgressBuf, ProgressBuf );
 					}
+
+					bx = ProgressBuf;
+					bc = c;
+				}
+
+				if( callProgress( bx, bc, evals0 + i + 1, i - pi ))
+				{
+					i++;
+					break;
 				}
 			}
 		}
 
-		return( StallCount );
-	}
-
-protected:
-	int ParamCount; ///< The total number of internal parameter values in use.
-	int OptCount; ///< The total number of optimization objects in use.
-	CBiteOptOwned< CBiteOpt >** Opts; ///< Optimization objects.
-	CBiteOptOwned< CBiteOpt >* BestOpt; ///< Optimizer that contains the best
-		///< solution.
-	CBiteOptOwned< CBiteOpt >* CurOpt; ///< Current optimizer object.
-	CBiteOptOwned< CBiteOpt >* PushOpt; ///< Optimizer where solution is
-		///< pushed to.
-	CBiteOptOwned< CBiteOpt >* LastOpt; ///< Latest optimizer object.
-	int StallCount; ///< The number of iterations without improvement.
-
-	/**
-	 * Function deletes previously allocated buffers.
-	 */
+		IsPolishing = false;
 
-	void deleteBuffers()
-	{
-		if( Opts != NULL )
+		if( PolishOpt.getBestCost() < *minf )
 		{
-			int i;
+			MaskAdapter.unpack( PolishOpt.getBestParams(), x );
+			*minf = PolishOpt.getBestCost();
 
-			for( i = 0; i < OptCount; i++ )
+			if( types != NULL )
 			{
-				delete Opts[ i ];
+				snapValues( x, x );
 			}
-
-			delete[] Opts;
-			Opts = NULL;
 		}
-	}
-};
 
-/**
- * Objective function.
- */
+		return( i );
+	}
 
-typedef double( *biteopt_func )( int N, const double* x, void* func_data );
+	/**
+	 * Function rounds active discrete parameters to the nearest integer
+	 * values within their bounds. Frozen parameters (see setParamMask()) are
+	 * left as supplied.
+	 *
+	 * @param p Parameter vector.
+	 * @param[out] sp Snapped parameter vector, can be equal to "p".
+	 */
 
-/**
- * Wrapper class for the biteopt_minimize() function.
- */
+	void snapValues( const double* const p, double* const sp ) const
+	{
+		if( sp != p )
+		{
+			memcpy( sp, p, N * sizeof( sp[ 0 ]));
+		}
 
-class CBiteOptMinimize : public CBiteOptDeep
-{
-public:
-	int N; ///< The number of dimensions in objective function.
-	biteopt_func f; ///< Objective function.
-	void* data; ///< Objective function's data.
-	const double* lb; ///< Parameters' lower bounds.
-	const double* ub; ///< Parameters' upper bounds.
+		const int* const ai = MaskAdapter.getActiveIdx();
+		int k;
 
-	virtual void getMinValues( double* const p ) const
-	{
-		memcpy( p, lb, N * sizeof( p[ 0 ]));
-	}
+		for( k = 0; k < MaskAdapter.getActiveCount(); k++ )
+		{
+			const int i = ai[ k ];
 
-	virtual void getMaxValues( double* const p ) const
-	{
-		memcpy( p, ub, N * sizeof( p[ 0 ]));
-	}
+			if( types[ i ] != ptContinuous )
+			{
+				const double lo = ceil( lb[ i ]);
+				const double hi = floor( ub[ i ]);
+				const double v = floor( p[ i ] + 0.5 );
 
-	virtual double optcost( const double* const p )
-	{
-		return(( *f )( N, p, data ));
+				sp[ i ] = ( v < lo ? lo : ( v > hi && hi >= lo ? hi : v ));
+			}
+		}
 	}
 };
 
@@ -1911,15 +4893,19 @@ public:
  * @param rdata Data pointer to pass to the "rf" function.
  * @param f_minp If non-zero, a pointer to the stopping value: optimization
  * will stop when this objective value is reached.
+ * @param seedp If non-zero, a pointer to the random seed. Each optimization
+ * attempt then uses its own PRNG stream of this seed, so that the outcome of
+ * an attempt does not depend on the preceding attempts. If zero, a single
+ * PRNG seeded with 1 is used for all attempts. Ignored, if "rf" is non-zero.
  * @return The total number of function evaluations performed; useful if the
  * "stopc" and/or "*f_minp" were used.
  */
 
-inline int biteopt_minimize( const int N, biteopt_func f, void* data,
+inline int64_t biteopt_minimize( const int N, biteopt_func f, void* data,
 	const double* lb, const double* ub, double* x, double* minf,
-	const int iter, const int M = 1, const int attc = 10,
+	const int64_t iter, const int M = 1, const int attc = 10,
 	const int stopc = 0, biteopt_rng rf = 0, void* rdata = 0,
-	double* f_minp = 0 )
+	double* f_minp = 0, const uint64_t* seedp = 0 )
 {
 	CBiteOptMinimize opt;
 	opt.N = N;
@@ -1927,56 +4913,9 @@ inline int biteopt_minimize( const int N, biteopt_func f, void* data,
 	opt.data = data;
 	opt.lb = lb;
 	opt.ub = ub;
-	opt.updateDims( N, M );
-
-	CBiteRnd rnd;
-	rnd.init( 1, rf, rdata );
-
-	const int sct = ( stopc <= 0 ? 0 : 128 * N * stopc );
-	const int useiter = (int) ( iter * sqrt( (double) M ));
-	int evals = 0;
-	int k;
-
-	for( k = 0; k < attc; k++ )
-	{
-		opt.init( rnd );
-
-		bool IsFinished = false;
-		int i;
-
-		for( i = 0; i < useiter; i++ )
-		{
-			const int sc = opt.optimize( rnd );
-
-			if( f_minp != 0 && opt.getBestCost() <= *f_minp )
-			{
-				evals++;
-				IsFinished = true;
-				break;
-			}
-
-			if( sct > 0 && sc >= sct )
-			{
-				evals++;
-				break;
-			}
-		}
-
-		evals += i;
-
-		if( k == 0 || opt.getBestCost() <= *minf )
-		{
-			memcpy( x, opt.getBestParams(), N * sizeof( x[ 0 ]));
-			*minf = opt.getBestCost();
-		}
-
-		if( IsFinished )
-		{
-			break;
-		}
-	}
 
-	return( evals );
+	return( opt.minimize( x, minf, iter, M, attc, stopc, rf, rdata, f_minp,
+		seedp ));
 }
 
 #endif // BITEOPT_INCLUDED
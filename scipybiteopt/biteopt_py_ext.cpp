@@ -24,24 +24,103 @@ static void free_with_array(PyArrayObject *arr, void *data) {
     PyArray_SetBaseObject(arr, capsule); // "steals" the reference
 }
 
+// pending signals are checked once per this many Python calls
+static const int signal_check_calls = 100;
+
+static bool check_abort(CBiteOptMinimize* opt, int* calls, bool failed) {
+    // on an exception raised by a Python callable, or by a signal handler
+    // (e.g. KeyboardInterrupt), the optimizer is asked to stop; the
+    // exception stays set and is raised once minimize() returns
+    if (!failed && ++(*calls) >= signal_check_calls) {
+        *calls = 0;
+        failed = (PyErr_CheckSignals() != 0);
+    }
+    if (failed) {
+        opt->abort();
+    }
+    return failed;
+}
+
+static double value_as_double(PyObject* ret) {
+    // steals the reference; NaN on a failed call or a non-numeric value
+    if (ret == NULL) {
+        return Py_NAN;
+    }
+    double v = PyFloat_AsDouble(ret);
+    Py_DECREF(ret);
+    if (v == -1.0 && PyErr_Occurred()) {
+        return Py_NAN;
+    }
+    return v;
+}
+
 static PyObject* minimize_func(PyObject* self, PyObject* args, PyObject *kwargs)
 {
     std::vector<double> upper, lower;
     PyObject * func_py = NULL;
     PyObject * upper_py = NULL;
     PyObject * lower_py = NULL;
-    int iter_py = 1;
+    long long iter_py = 1;
     int M_py = 1;
     int attc_py = 10;
     int stopc_py = 1;
-    static const char *kwlist[] = {"func", "lower", "upper", "iter", "Mi", "attc", "stopc", NULL};
+    PyObject * seed_py = Py_None;
+    int cache_size_py = 0;
+    const char * cache_file_py = NULL;
+    const char * cache_tag_py = NULL;
+    int prescreen_py = 0;
+    int cost_bound_py = 0;
+    PyObject * delta_func_py = Py_None;
+    PyObject * cns_func_py = Py_None;
+    int n_cns_py = 0;
+    int n_obj_py = 1;
+    double ftol_py = 0.0;
+    double xtol_py = 0.0;
+    long long polish_iter_py = 0;
+    PyObject * types_py = Py_None;
+    int gen_stats_py = 0;
+    const char * trace_file_py = NULL;
+    const char * eval_log_py = NULL;
+    PyObject * progress_func_py = Py_None;
+    long long progress_evals_py = 0;
+    double progress_time_py = 0.0;
+    double maxtime_py = 0.0;
+    PyObject * f_target_py = Py_None;
+    int fast_rng_py = 0;
+    static const char *kwlist[] = {"func", "lower", "upper", "iter", "Mi", "attc", "stopc", "seed", "cache_size",
+                                   "cache_file", "cache_tag", "prescreen", "cost_bound", "delta_func", "cns_func",
+                                   "n_cns", "n_obj", "ftol", "xtol", "polish_iter", "types", "gen_stats", "trace_file", "eval_log", "progress_func", "progress_evals",
+                                   "progress_time", "maxtime", "f_target", "fast_rng", NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OOO|iiii", const_cast<char**>(kwlist),
-                                     &func_py, &lower_py, &upper_py, &iter_py, &M_py, &attc_py, &stopc_py))
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OOO|LiiiOizziiOOiiddLOizzOLddOi", const_cast<char**>(kwlist),
+                                     &func_py, &lower_py, &upper_py, &iter_py, &M_py, &attc_py, &stopc_py, &seed_py,
+                                     &cache_size_py, &cache_file_py, &cache_tag_py, &prescreen_py, &cost_bound_py,
+                                     &delta_func_py, &cns_func_py, &n_cns_py, &n_obj_py, &ftol_py, &xtol_py, &polish_iter_py,
+                                     &types_py, &gen_stats_py, &trace_file_py, &eval_log_py,
+                                     &progress_func_py, &progress_evals_py, &progress_time_py,
+                                     &maxtime_py, &f_target_py, &fast_rng_py))
     {
         return NULL;
     }
 
+    uint64_t seed = 0;
+    if (seed_py != Py_None) {
+        seed = PyLong_AsUnsignedLongLongMask(seed_py);
+        if(PyErr_Occurred()) {
+            PyErr_SetString(PyExc_TypeError, "minimize: seed must be an integer or None");
+            return 0;
+        }
+    }
+
+
+    double f_target = 0.0;
+    if (f_target_py != Py_None) {
+        f_target = PyFloat_AsDouble(f_target_py);
+        if(PyErr_Occurred()) {
+            PyErr_SetString(PyExc_TypeError, "minimize: f_target must be a number or None");
+            return 0;
+        }
+    }
 
     PyObject *iter = PyObject_GetIter(lower_py);
     if (!iter) {
@@ -89,46 +168,419 @@ static PyObject* minimize_func(PyObject* self, PyObject* args, PyObject *kwargs)
             return 0;
         }
     }
+    std::vector<int> types;
+    if (types_py != Py_None) {
+        iter = PyObject_GetIter(types_py);
+        if (!iter) {
+            PyErr_SetString(PyExc_TypeError, "minimize: types must be a list or None");
+            return 0;
+        }
+
+        while (true) {
+            PyObject *next = PyIter_Next(iter);
+            if (!next)
+                break;
+
+            types.push_back(PyLong_AsLong(next));
+            if(PyErr_Occurred()) {
+                PyErr_SetString(PyExc_TypeError, "minimize: integer list of types is required");
+                return 0;
+            }
+        }
+
+        if(types.size() != lower.size()) {
+            PyErr_SetString(PyExc_TypeError, "minimize: types should match bounds in length");
+            return 0;
+        }
+    }
+    CBiteStore store;
+    if (cache_file_py != NULL) {
+        if (!store.open(cache_file_py, lower.size(), lower.data(), upper.data(), cache_tag_py)) {
+            PyErr_SetString(PyExc_OSError, "minimize: cannot open cache_file, or it was created for a different dimension");
+            return 0;
+        }
+    }
+
+    CBiteEvalLog eval_log;
+    if (eval_log_py != NULL) {
+        if (!eval_log.open(eval_log_py, lower.size(), CBiteOpt::GenCount, CBiteOpt::getGenNames())) {
+            PyErr_SetString(PyExc_OSError, "minimize: cannot create eval_log");
+            return 0;
+        }
+    }
+
     double* best_x = reinterpret_cast<double*>(calloc(lower.size(), sizeof(double)));
     double min_f;
-    int n_fev;
+    long long n_fev;
 
 
 
     struct FuncData {
         PyObject* func;
+        PyObject* delta_func;
+        PyObject* cns_func;
+        int n_cns;
+        int n_obj;
+        PyObject* progress_func;
+        CBiteOptMinimize* opt;
+        int calls;
     };
 
+    // after an abort, the remaining evaluations of the current iteration
+    // return NaN without calling into Python
     auto closure = [](int N, const double* x, void* func_data ) {
+        auto func_f = static_cast<FuncData*>(func_data);
+        if (func_f->opt->isAborted()) {
+            return Py_NAN;
+        }
         npy_intp dims[1];
         dims[0] = N;
         PyObject *arr = PyArray_SimpleNewFromData(1, dims,NPY_DOUBLE, (void *)x);
+        double fun = value_as_double( PyObject_CallFunctionObjArgs(func_f->func, arr,NULL));
+        Py_DECREF(arr);
+        check_abort(func_f->opt, &func_f->calls, PyErr_Occurred() != NULL);
+        return fun;
+    };
+
+    // objective function called with the cost_bound keyword argument
+    auto closure_b = [](int N, const double* x, void* func_data, double bound ) {
         auto func_f = static_cast<FuncData*>(func_data);
-        double fun = PyFloat_AsDouble( PyObject_CallFunctionObjArgs(func_f->func, arr,NULL));
+        if (func_f->opt->isAborted()) {
+            return Py_NAN;
+        }
+        npy_intp dims[1];
+        dims[0] = N;
+        PyObject *arr = PyArray_SimpleNewFromData(1, dims,NPY_DOUBLE, (void *)x);
+        PyObject *args_b = PyTuple_Pack(1, arr);
+        PyObject *kwargs_b = Py_BuildValue("{s:d}", "cost_bound", (bound >= 1e300 ? Py_HUGE_VAL : bound));
+        double fun = value_as_double( PyObject_Call(func_f->func, args_b, kwargs_b));
+        Py_DECREF(kwargs_b);
+        Py_DECREF(args_b);
         Py_DECREF(arr);
+        check_abort(func_f->opt, &func_f->calls, PyErr_Occurred() != NULL);
         return fun;
     };
 
-    FuncData fdata = {func_py}; // maybe add pass-thru args later
-    n_fev = biteopt_minimize( lower.size(), closure, (void*)&fdata, lower.data(), upper.data(), best_x, &min_f, iter_py,M_py,attc_py, stopc_py);
+    // delta_func(x, parent_x, parent_f, changed) if the parent is known,
+    // func(x) otherwise
+    auto closure_d = [](int N, const double* x, const double* px, double pf, int nc, const int* ci,
+                        void* func_data ) {
+        auto func_f = static_cast<FuncData*>(func_data);
+        if (func_f->opt->isAborted()) {
+            return Py_NAN;
+        }
+        npy_intp dims[1];
+        dims[0] = N;
+        PyObject *arr = PyArray_SimpleNewFromData(1, dims,NPY_DOUBLE, (void *)x);
+        PyObject *ret;
+        if (nc < 0) {
+            ret = PyObject_CallFunctionObjArgs(func_f->func, arr, NULL);
+        } else {
+            PyObject *parr = PyArray_SimpleNewFromData(1, dims,NPY_DOUBLE, (void *)px);
+            npy_intp dims_c[1];
+            dims_c[0] = nc;
+            PyObject *carr = PyArray_SimpleNewFromData(1, dims_c,NPY_INT, (void *)ci);
+            PyObject *pf_py = PyFloat_FromDouble(pf);
+            ret = PyObject_CallFunctionObjArgs(func_f->delta_func, arr, parr, pf_py, carr, NULL);
+            Py_DECREF(pf_py);
+            Py_DECREF(carr);
+            Py_DECREF(parr);
+        }
+        double fun = value_as_double(ret);
+        Py_DECREF(arr);
+        check_abort(func_f->opt, &func_f->calls, PyErr_Occurred() != NULL);
+        return fun;
+    };
+
+    // cns_func(x) returns n_cns constraint values, <= 0 if satisfied;
+    // values that cannot be obtained are set to NaN (violated)
+    auto closure_c = [](int N, const double* x, double* c, void* func_data ) {
+        auto func_f = static_cast<FuncData*>(func_data);
+        if (func_f->opt->isAborted()) {
+            for (int i = 0; i < func_f->n_cns; i++) {
+                c[i] = Py_NAN;
+            }
+            return;
+        }
+        npy_intp dims[1];
+        dims[0] = N;
+        PyObject *arr = PyArray_SimpleNewFromData(1, dims,NPY_DOUBLE, (void *)x);
+        PyObject *ret = PyObject_CallFunctionObjArgs(func_f->cns_func, arr, NULL);
+        PyObject *seq = (ret != NULL ? PySequence_Fast(ret, "constraint values must be a sequence") : NULL);
+        for (int i = 0; i < func_f->n_cns; i++) {
+            c[i] = (seq != NULL && i < PySequence_Fast_GET_SIZE(seq) ?
+                PyFloat_AsDouble(PySequence_Fast_GET_ITEM(seq, i)) : Py_NAN);
+        }
+        Py_XDECREF(seq);
+        Py_XDECREF(ret);
+        Py_DECREF(arr);
+        check_abort(func_f->opt, &func_f->calls, PyErr_Occurred() != NULL);
+    };
+
+    // func(x) returns n_obj objective values in multi-objective mode;
+    // values that cannot be obtained are set to NaN
+    auto closure_m = [](int N, const double* x, double* f, void* func_data ) {
+        auto func_f = static_cast<FuncData*>(func_data);
+        if (func_f->opt->isAborted()) {
+            for (int i = 0; i < func_f->n_obj; i++) {
+                f[i] = Py_NAN;
+            }
+            return;
+        }
+        npy_intp dims[1];
+        dims[0] = N;
+        PyObject *arr = PyArray_SimpleNewFromData(1, dims,NPY_DOUBLE, (void *)x);
+        PyObject *ret = PyObject_CallFunctionObjArgs(func_f->func, arr, NULL);
+        PyObject *seq = (ret != NULL ? PySequence_Fast(ret, "objective values must be a sequence") : NULL);
+        for (int i = 0; i < func_f->n_obj; i++) {
+            f[i] = (seq != NULL && i < PySequence_Fast_GET_SIZE(seq) ?
+                PyFloat_AsDouble(PySequence_Fast_GET_ITEM(seq, i)) : Py_NAN);
+        }
+        Py_XDECREF(seq);
+        Py_XDECREF(ret);
+        Py_DECREF(arr);
+        check_abort(func_f->opt, &func_f->calls, PyErr_Occurred() != NULL);
+    };
+
+    // progress_func(x, fun, nfev, stall) with a read-only view of the best
+    // solution; a true return value stops the optimization, as does an
+    // exception, which is then propagated
+    auto closure_p = [](int N, const double* x, double f, int64_t nfev, int64_t stall,
+                        void* func_data ) {
+        auto func_f = static_cast<FuncData*>(func_data);
+        npy_intp dims[1];
+        dims[0] = N;
+        PyObject *arr = PyArray_SimpleNewFromData(1, dims,NPY_DOUBLE, (void *)x);
+        PyArray_CLEARFLAGS(reinterpret_cast<PyArrayObject*>(arr), NPY_ARRAY_WRITEABLE);
+        PyObject *ret = PyObject_CallFunction(func_f->progress_func, "OdLL", arr, f,
+            (long long)nfev, (long long)stall);
+        Py_DECREF(arr);
+        const bool stop = (ret == NULL || PyObject_IsTrue(ret) != 0);
+        Py_XDECREF(ret);
+        check_abort(func_f->opt, &func_f->calls, PyErr_Occurred() != NULL);
+        return stop;
+    };
+
+    CBiteTracer tracer;
+    CBiteOptMinimize opt;
+    FuncData fdata = {func_py, delta_func_py, cns_func_py, n_cns_py, n_obj_py,
+                      progress_func_py, &opt, 0}; // maybe add pass-thru args later
+    opt.N = lower.size();
+    opt.f = closure;
+    if (cost_bound_py != 0) {
+        opt.fb = closure_b;
+    }
+    if (delta_func_py != Py_None) {
+        opt.fd = closure_d;
+    }
+    if (cns_func_py != Py_None && n_cns_py > 0) {
+        opt.fc = closure_c;
+        opt.NC = n_cns_py;
+    }
+    if (n_obj_py > 1) {
+        opt.fm = closure_m;
+        opt.NO = n_obj_py;
+    }
+    if (progress_func_py != Py_None) {
+        opt.fp = closure_p;
+        opt.ProgressEvals = progress_evals_py;
+        opt.ProgressTime = progress_time_py;
+    }
+    opt.data = (void*)&fdata;
+    opt.lb = lower.data();
+    opt.ub = upper.data();
+    opt.types = (types.empty() ? NULL : types.data());
+    opt.setEvalCacheSize(cache_size_py);
+    opt.Store = (store.isOpen() ? &store : NULL);
+    opt.EvalLog = (eval_log.isOpen() ? &eval_log : NULL);
+    opt.setPrescreen(prescreen_py != 0);
+    opt.setGenStats(gen_stats_py != 0);
+    opt.setTracer(trace_file_py != NULL ? &tracer : NULL);
+    opt.ftol = ftol_py;
+    opt.xtol = xtol_py;
+    opt.PolishIter = polish_iter_py;
+    opt.MaxTime = maxtime_py;
+    opt.FastRnd = (fast_rng_py != 0);
+    n_fev = opt.minimize(best_x, &min_f, iter_py, M_py, attc_py, stopc_py,
+        0, 0, (f_target_py != Py_None ? &f_target : 0), (seed_py != Py_None ? &seed : 0));
+
+    // an exception raised by a callable (or a signal) aborted the
+    // optimization; it is raised after the logs are written, with the
+    // best solution found so far attached
+    PyObject *exc_type, *exc_value, *exc_tb;
+    PyErr_Fetch(&exc_type, &exc_value, &exc_tb);
+
+    if (!eval_log.close() && exc_type == NULL) {
+        free(best_x);
+        PyErr_SetString(PyExc_OSError, "minimize: cannot write eval_log");
+        return 0;
+    }
+
+    if (trace_file_py != NULL && !tracer.write(trace_file_py) && exc_type == NULL) {
+        free(best_x);
+        PyErr_SetString(PyExc_OSError, "minimize: cannot write trace_file");
+        return 0;
+    }
+
+    // additional statistics, returned as a dict
+    PyObject *info = PyDict_New();
+    PyObject *calls = PyLong_FromLongLong(opt.FuncCallCount);
+    PyDict_SetItemString(info, "fun_calls", calls);
+    Py_DECREF(calls);
+    if (cache_size_py > 0) {
+        PyObject *hits = PyLong_FromLongLong(opt.getEvalCacheHits());
+        PyObject *misses = PyLong_FromLongLong(opt.getEvalCacheMisses());
+        PyDict_SetItemString(info, "cache_hits", hits);
+        PyDict_SetItemString(info, "cache_misses", misses);
+        Py_DECREF(hits);
+        Py_DECREF(misses);
+    }
+    if (prescreen_py != 0) {
+        PyObject *saved = PyLong_FromLongLong(opt.getPrescreenSaved());
+        PyDict_SetItemString(info, "prescreen_saved", saved);
+        Py_DECREF(saved);
+    }
+    if (cost_bound_py != 0) {
+        PyObject *exceeded = PyLong_FromLongLong(opt.BoundExceedCount);
+        PyDict_SetItemString(info, "bound_exceeded", exceeded);
+        Py_DECREF(exceeded);
+    }
+    if (delta_func_py != Py_None) {
+        PyObject *deltas = PyLong_FromLongLong(opt.DeltaEvalCount);
+        PyDict_SetItemString(info, "delta_evals", deltas);
+        Py_DECREF(deltas);
+    }
+    if (maxtime_py > 0.0) {
+        PyDict_SetItemString(info, "time_stop", opt.IsTimeStop ? Py_True : Py_False);
+    }
+    if (progress_func_py != Py_None) {
+        PyDict_SetItemString(info, "callback_stop", opt.IsProgressStop ? Py_True : Py_False);
+    }
+    if (polish_iter_py > 0) {
+        PyObject *nfev_global = PyLong_FromLongLong(n_fev - opt.PolishEvalCount);
+        PyObject *nfev_polish = PyLong_FromLongLong(opt.PolishEvalCount);
+        PyDict_SetItemString(info, "nfev_global", nfev_global);
+        PyDict_SetItemString(info, "nfev_polish", nfev_polish);
+        Py_DECREF(nfev_global);
+        Py_DECREF(nfev_polish);
+    }
+    if (!types.empty()) {
+        PyObject *dups = PyLong_FromLongLong(opt.getDupSaved());
+        PyDict_SetItemString(info, "dup_saved", dups);
+        Py_DECREF(dups);
+    }
+    if (gen_stats_py != 0) {
+        // per-generator statistics, as a dict of dicts keyed by generator name
+        const CBiteGenStats& gs = opt.getGenStats();
+        PyObject *gens = PyDict_New();
+        for (int i = 0; i < gs.getGenCount(); i++) {
+            PyObject *hist = PyList_New(CBiteGenStats::RankBinCount);
+            for (int k = 0; k < CBiteGenStats::RankBinCount; k++) {
+                PyList_SET_ITEM(hist, k, PyLong_FromLongLong(gs.getRankHist(i)[k]));
+            }
+            PyObject *gen = Py_BuildValue("{s:L,s:L,s:N,s:L}",
+                "selected", (long long)gs.getSelCount(i),
+                "accepted", (long long)gs.getAcceptCount(i),
+                "rank_hist", hist,
+                "ticks", (long long)gs.getGenTicks(i));
+            PyDict_SetItemString(gens, gs.getGenName(i), gen);
+            Py_DECREF(gen);
+        }
+        PyObject *eval_ticks = PyLong_FromLongLong(gs.getEvalTicks());
+        PyDict_SetItemString(info, "gen_stats", gens);
+        PyDict_SetItemString(info, "eval_ticks", eval_ticks);
+        Py_DECREF(gens);
+        Py_DECREF(eval_ticks);
+    }
+    if (store.isOpen()) {
+        PyObject *hits = PyLong_FromLongLong(store.getHitCount());
+        PyObject *misses = PyLong_FromLongLong(store.getMissCount());
+        PyDict_SetItemString(info, "store_hits", hits);
+        PyDict_SetItemString(info, "store_misses", misses);
+        Py_DECREF(hits);
+        Py_DECREF(misses);
+    }
+    if (n_obj_py > 1) {
+        // Pareto front as (count, N) and (count, n_obj) arrays
+        const CBiteParetoArchive& pa = opt.getParetoArchive();
+        npy_intp dims_x[2] = {pa.getCount(), (npy_intp)lower.size()};
+        npy_intp dims_f[2] = {pa.getCount(), n_obj_py};
+        PyObject *px = PyArray_SimpleNew(2, dims_x, NPY_DOUBLE);
+        PyObject *pf = PyArray_SimpleNew(2, dims_f, NPY_DOUBLE);
+        double *pxd = (double*)PyArray_DATA(reinterpret_cast<PyArrayObject*>(px));
+        double *pfd = (double*)PyArray_DATA(reinterpret_cast<PyArrayObject*>(pf));
+        for (int i = 0; i < pa.getCount(); i++) {
+            memcpy(pxd + i * lower.size(), pa.getValues(i), lower.size() * sizeof(double));
+            memcpy(pfd + i * n_obj_py, pa.getObjs(i), n_obj_py * sizeof(double));
+        }
+        PyDict_SetItemString(info, "pareto_x", px);
+        PyDict_SetItemString(info, "pareto_fun", pf);
+        Py_DECREF(px);
+        Py_DECREF(pf);
+    }
 
     PyObject *fun = PyFloat_FromDouble(min_f);
-    PyObject *nfev = PyLong_FromLong(n_fev);
+    PyObject *nfev = PyLong_FromLongLong(n_fev);
     npy_intp dims_res[1];
     int dimensions = lower.size();
     dims_res[0] = dimensions;
 
     PyObject *res = PyArray_SimpleNewFromData(1, dims_res,NPY_DOUBLE,(void *)best_x);
     free_with_array(reinterpret_cast<PyArrayObject*>(res), static_cast<void*>(best_x));
-    PyObject *result = PyTuple_Pack(3, fun, res, nfev);
+    PyObject *result = PyTuple_Pack(4, fun, res, nfev, info);
     Py_DECREF(res); // tuple keeps reference to array; drop original reference
+    Py_DECREF(info);
+
+    if (exc_type != NULL) {
+        PyErr_NormalizeException(&exc_type, &exc_value, &exc_tb);
+        if (exc_value != NULL &&
+            PyObject_SetAttrString(exc_value, "_biteopt_result", result) != 0) {
+            PyErr_Clear(); // e.g. an exception type with __slots__
+        }
+        PyErr_Restore(exc_type, exc_value, exc_tb);
+        Py_DECREF(result);
+        return NULL;
+    }
+
     return result;
 }
 
+static PyObject* engine_stats_func(PyObject* self, PyObject* args, PyObject *kwargs)
+{
+    int reset_py = 0;
+    static const char *kwlist[] = {"reset", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|i", const_cast<char**>(kwlist), &reset_py))
+    {
+        return NULL;
+    }
+
+#if defined(BITEOPT_STATS)
+    CBiteStats& st = CBiteStats::get();
+    PyObject *res = Py_BuildValue("{s:L,s:L,s:L,s:L,s:L,s:L,s:L,s:L,s:L}",
+        "evals", (long long)st.EvalCount,
+        "rnd_draws", (long long)st.RndDraws,
+        "update_pop_calls", (long long)st.UpdatePopCalls,
+        "update_pop_rejects", (long long)st.UpdatePopRejects,
+        "update_pop_replaces", (long long)st.UpdatePopReplaces,
+        "move_dist", (long long)st.MoveDist,
+        "centroid_recomputes", (long long)st.CentRecomputes,
+        "centroid_dist_calls", (long long)st.CentDistCalls,
+        "wrap_hits", (long long)st.WrapHits);
+    if (reset_py != 0) {
+        st.clear();
+    }
+    return res;
+#else
+    Py_RETURN_NONE;
+#endif
+}
+
 /*  define functions in module */
 static PyMethodDef biteoptMethods[] =
 {
-     {"_minimize",(PyCFunction) minimize_func,  METH_VARARGS | METH_KEYWORDS, "func lower_bound (list) upper_bound (list) iter (int) M (int) attc (int) stopc (int)"},
+     {"_minimize",(PyCFunction) minimize_func,  METH_VARARGS | METH_KEYWORDS, "func lower_bound (list) upper_bound (list) iter (int) M (int) attc (int) stopc (int) seed (int or None) cache_size (int) cache_file (str or None) cache_tag (str or None) prescreen (int) cost_bound (int) delta_func (callable or None) cns_func (callable or None) n_cns (int) n_obj (int) ftol (float) xtol (float) polish_iter (int) types (list of int or None) gen_stats (int) trace_file (str or None) eval_log (str or None) progress_func (callable or None) progress_evals (int) progress_time (float) maxtime (float) f_target (float or None) fast_rng (int)"},
+     {"_engine_stats",(PyCFunction) engine_stats_func,  METH_VARARGS | METH_KEYWORDS, "reset (int); returns a dict of hot-path counters, or None if built without BITEOPT_STATS"},
      {NULL, NULL, 0, NULL}
 };
 
@@ -0,0 +1,818 @@
+//$ nocpp
+
+/**
+ * @file biteoptcc.h
+ *
+ * @version 2024.6
+ *
+ * @brief The inclusion file for the CBiteOptCoop class.
+ *
+ * @section license License
+ *
+ * Copyright (c) 2016-2024 Aleksey Vaneev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef BITEOPTCC_INCLUDED
+#define BITEOPTCC_INCLUDED
+
+#include <thread>
+#include "biteopt.h"
+
+/**
+ * Cooperative coevolution group class. Owns a CBiteOpt optimizer that works
+ * on the group's parameters, while the remaining parameters are held at the
+ * values of the context vector. Tracks the best solution found since the
+ * latest setContext() call.
+ */
+
+class CBiteOptCoopGroup : public CBiteOptMaskAdapter
+{
+public:
+	CBiteOptOwned< CBiteOpt > Opt; ///< Group's optimizer.
+	CBiteRnd rnd; ///< Group's random number generator.
+	double BestCost; ///< The best cost since the latest setContext() call.
+	double* BestParams; ///< The best compact parameter vector.
+	double LastCost; ///< Cost obtained at the latest evaluation.
+	double* LastValues; ///< Owner's vector of the latest evaluation.
+	int64_t EvalCount; ///< The number of evaluations performed.
+
+	CBiteOptCoopGroup( CBiteOptInterface* const aOwner )
+		: CBiteOptMaskAdapter( aOwner )
+		, Opt( this )
+		, BestCost( 1e300 )
+		, BestParams( NULL )
+		, LastCost( 1e300 )
+		, LastValues( NULL )
+		, EvalCount( 0 )
+	{
+	}
+
+	virtual ~CBiteOptCoopGroup()
+	{
+		delete[] BestParams;
+		delete[] LastValues;
+	}
+
+	/**
+	 * Function assigns the group's parameters, and dimensions the group's
+	 * optimizer accordingly.
+	 *
+	 * @param aParamCount The number of the owner's parameters.
+	 * @param Active Group membership flags of the owner's parameters.
+	 * @param Values Context vector.
+	 */
+
+	void setParams( const int aParamCount, const bool* const Active,
+		const double* const Values )
+	{
+		CBiteOptMaskAdapter :: updateDims( aParamCount );
+		setMask( Active, Values );
+
+		delete[] BestParams;
+		delete[] LastValues;
+		BestParams = new double[ ActiveCount ];
+		LastValues = new double[ ParamCount ];
+
+		Opt.updateDims( ActiveCount );
+	}
+
+	/**
+	 * Function assigns the context vector, and resets the best solution to
+	 * it.
+	 *
+	 * @param Values Context vector.
+	 * @param Cost Context vector's cost.
+	 */
+
+	void setContext( const double* const Values, const double Cost )
+	{
+		memcpy( FullValues, Values, ParamCount * sizeof( FullValues[ 0 ]));
+		pack( Values, BestParams );
+		BestCost = Cost;
+	}
+
+	/**
+	 * Function performs the specified number of optimizer's iterations.
+	 *
+	 * @param IterCount The number of iterations, 0 - the optimizer's
+	 * population size.
+	 */
+
+	void run( const int IterCount )
+	{
+		const int ic = ( IterCount > 0 ? IterCount : Opt.getCurPopSize() );
+		int i;
+
+		for( i = 0; i < ic; i++ )
+		{
+			Opt.optimize( rnd );
+		}
+	}
+
+	virtual double optrank( const double* const p )
+	{
+		unpack( p, LastValues );
+		LastCost = Owner -> optrank( LastValues );
+		EvalCount++;
+
+		if( LastCost < BestCost )
+		{
+			BestCost = LastCost;
+			memcpy( BestParams, p, ActiveCount * sizeof( BestParams[ 0 ]));
+		}
+
+		return( LastCost );
+	}
+};
+
+/**
+ * Cooperative coevolution optimization class. Partitions parameters into
+ * groups, each optimized by its own CBiteOpt object, against a shared
+ * context vector which holds the best solution found so far. This is
+ * efficient for very high-dimensional partially separable functions, as
+ * population size and per-evaluation overhead of each optimizer are
+ * bounded by the group size, and not by the total number of parameters.
+ *
+ * Groups can be assigned via the setGroups() function, or learned from
+ * variable interactions via the learnGroups() function.
+ *
+ * An optimization cycle gives each group a turn of iterations. With a
+ * single thread, groups take turns sequentially, and each group starts its
+ * turn with the context vector updated by the preceding groups. With
+ * several threads, groups take turns concurrently against the context
+ * vector of the cycle's start, and improvements are merged at the cycle's
+ * end. In this case, optcost() should be thread-safe.
+ *
+ * Like CBiteOptDeep, this class should be derived from, with the
+ * getMinValues(), getMaxValues() and optcost() functions implemented.
+ * Constraints and multiple objectives are not supported.
+ */
+
+class CBiteOptCoop : public CBiteOptInterface
+{
+public:
+	CBiteOptCoop()
+		: ParamCount( 0 )
+		, GroupCount( 0 )
+		, Groups( NULL )
+		, GroupIdx( NULL )
+		, ThreadCount( 1 )
+		, TurnIters( 0 )
+		, BestValues( NULL )
+		, BestCost( 1e300 )
+		, MergeValues( NULL )
+		, TmpValues( NULL )
+		, MinValues( NULL )
+		, MaxValues( NULL )
+		, LastCostPtr( NULL )
+		, LastValuesPtr( NULL )
+		, EvalCount( 0 )
+		, StallCount( 0 )
+		, LearnEps( 0.0 )
+		, LearnEvals( 0 )
+	{
+	}
+
+	virtual ~CBiteOptCoop()
+	{
+		deleteGroups();
+		deleteBuffers();
+	}
+
+	/**
+	 * Function updates dimensionality of *this object, and assigns all
+	 * parameters to a single group. Function does nothing if dimensionality
+	 * has not changed since the last call. This function should be called
+	 * at least once before calling the init() function.
+	 *
+	 * @param aParamCount The number of parameters being optimized.
+	 */
+
+	void updateDims( const int aParamCount )
+	{
+		if( aParamCount == ParamCount )
+		{
+			return;
+		}
+
+		deleteBuffers();
+
+		ParamCount = aParamCount;
+		GroupIdx = new int[ ParamCount ];
+		BestValues = new double[ ParamCount ];
+		MergeValues = new double[ ParamCount ];
+		TmpValues = new double[ ParamCount ];
+		MinValues = new double[ ParamCount ];
+		MaxValues = new double[ ParamCount ];
+
+		memset( GroupIdx, 0, ParamCount * sizeof( GroupIdx[ 0 ]));
+		setGroups( GroupIdx );
+	}
+
+	/**
+	 * Function assigns parameter groups, and creates group optimizers. The
+	 * init() function should be called after this function.
+	 *
+	 * @param aGroupIdx Group index of each parameter, ParamCount elements.
+	 * Indices should be in the range [0; ParamCount-1], indices not used by
+	 * any parameter are skipped.
+	 * @return The number of groups created.
+	 */
+
+	int setGroups( const int* const aGroupIdx )
+	{
+		deleteGroups();
+
+		bool* const Active = new bool[ ParamCount ];
+		int* const Remap = new int[ ParamCount ];
+		int i;
+
+		for( i = 0; i < ParamCount; i++ )
+		{
+			Remap[ i ] = -1;
+		}
+
+		for( i = 0; i < ParamCount; i++ )
+		{
+			const int g = aGroupIdx[ i ];
+
+			if( Remap[ g ] < 0 )
+			{
+				Remap[ g ] = GroupCount;
+				GroupCount++;
+			}
+		}
+
+		for( i = 0; i < ParamCount; i++ )
+		{
+			GroupIdx[ i ] = Remap[ aGroupIdx[ i ]];
+			BestValues[ i ] = 0.0;
+		}
+
+		Groups = new CBiteOptCoopGroup*[ GroupCount ];
+		int g;
+
+		for( g = 0; g < GroupCount; g++ )
+		{
+			for( i = 0; i < ParamCount; i++ )
+			{
+				Active[ i ] = ( GroupIdx[ i ] == g );
+			}
+
+			Groups[ g ] = new CBiteOptCoopGroup( this );
+			Groups[ g ] -> setParams( ParamCount, Active, BestValues );
+		}
+
+		delete[] Active;
+		delete[] Remap;
+
+		return( GroupCount );
+	}
+
+	/**
+	 * Function learns parameter groups from variable interactions, using
+	 * the recursive differential grouping method: a set of parameters is
+	 * tested for interaction with another set by checking whether the
+	 * objective function's difference due to a change of the first set
+	 * depends on the values of the second set. Interacting sets are then
+	 * bisected to find the interacting parameters, which requires
+	 * O(N*log(N)) objective function evaluations. Connected components of
+	 * interacting parameters are then packed into groups not larger than
+	 * MaxGroupSize; larger components form their own groups. Calls the
+	 * setGroups() function.
+	 *
+	 * @param MaxGroupSize Group size limit for packing, 0 - use the default
+	 * of 50.
+	 * @param Eps Interaction threshold, relative to the sum of magnitudes of
+	 * the compared function values. This value should be larger than the
+	 * objective function's relative rounding error.
+	 * @return The number of objective function evaluations performed.
+	 */
+
+	int learnGroups( const int MaxGroupSize = 0, const double Eps = 1e-10 )
+	{
+		getMinValues( MinValues );
+		getMaxValues( MaxValues );
+
+		const int mgs = ( MaxGroupSize > 0 ? MaxGroupSize : 50 );
+		int* const Rest = new int[ ParamCount ];
+		int* const NewIdx = new int[ ParamCount ];
+		double* const UpValues = new double[ ParamCount ];
+		int i;
+
+		for( i = 0; i < ParamCount; i++ )
+		{
+			Rest[ i ] = i;
+		}
+
+		memcpy( UpValues, MinValues, ParamCount * sizeof( UpValues[ 0 ]));
+
+		LearnEps = Eps;
+		LearnEvals = 1;
+		const double fll = optcost( MinValues );
+
+		int* v = Rest; // Parameters not yet assigned to components.
+		int vc = ParamCount;
+		int gi = -1; // Current group index.
+		int gs = mgs; // Current group's size.
+
+		while( vc > 0 )
+		{
+			// Start a new component with the first remaining parameter,
+			// and extend it with interacting parameters, until none left.
+
+			int* const cv = v;
+			UpValues[ v[ 0 ]] = MaxValues[ v[ 0 ]];
+			v++;
+			vc--;
+
+			while( vc > 0 )
+			{
+				LearnEvals++;
+				const double ful = optcost( UpValues );
+				const int c = findInteract( v, vc, UpValues, fll, ful );
+
+				if( c == 0 )
+				{
+					break;
+				}
+
+				for( i = 0; i < c; i++ )
+				{
+					UpValues[ v[ i ]] = MaxValues[ v[ i ]];
+				}
+
+				v += c;
+				vc -= c;
+			}
+
+			const int cs = (int) ( v - cv );
+
+			if( gs + cs > mgs )
+			{
+				gi++;
+				gs = 0;
+			}
+
+			gs += cs;
+
+			for( i = 0; i < cs; i++ )
+			{
+				NewIdx[ cv[ i ]] = gi;
+				UpValues[ cv[ i ]] = MinValues[ cv[ i ]];
+			}
+		}
+
+		setGroups( NewIdx );
+
+		delete[] Rest;
+		delete[] NewIdx;
+		delete[] UpValues;
+
+		return( LearnEvals );
+	}
+
+	/**
+	 * Function sets the number of threads to use for group turns. Default
+	 * is 1.
+	 *
+	 * @param aThreadCount The number of threads.
+	 */
+
+	void setThreadCount( const int aThreadCount )
+	{
+		ThreadCount = ( aThreadCount < 1 ? 1 : aThreadCount );
+	}
+
+	/**
+	 * Function sets the number of iterations of each group's turn. Default
+	 * is 0, which uses the group optimizer's population size.
+	 *
+	 * @param aTurnIters The number of iterations.
+	 */
+
+	void setTurnIters( const int aTurnIters )
+	{
+		TurnIters = aTurnIters;
+	}
+
+	/**
+	 * @return The number of parameter groups.
+	 */
+
+	int getGroupCount() const
+	{
+		return( GroupCount );
+	}
+
+	/**
+	 * @return Group index of each parameter, ParamCount elements.
+	 */
+
+	const int* getGroupIdx() const
+	{
+		return( GroupIdx );
+	}
+
+	/**
+	 * @return The number of objective function evaluations performed since
+	 * the latest init() call.
+	 */
+
+	int64_t getEvalCount() const
+	{
+		int64_t c = EvalCount;
+		int g;
+
+		for( g = 0; g < GroupCount; g++ )
+		{
+			c += Groups[ g ] -> EvalCount;
+		}
+
+		return( c );
+	}
+
+	virtual const double* getBestParams() const
+	{
+		return( BestValues );
+	}
+
+	virtual double getBestCost() const
+	{
+		return( BestCost );
+	}
+
+	virtual const double* getLastCosts() const
+	{
+		return( LastCostPtr );
+	}
+
+	virtual const double* getLastValues() const
+	{
+		return( LastValuesPtr );
+	}
+
+	/**
+	 * Function initializes *this optimizer: evaluates the initial context
+	 * vector, and initializes group optimizers. Group optimizers perform
+	 * their initial evaluations during their first turns.
+	 *
+	 * @param rnd Random number generator, used to seed the generators of
+	 * groups.
+	 * @param InitParams Initial context vector. If NULL, a random vector
+	 * within the parameter ranges is used.
+	 * @param InitRadius Initial radius of group optimizers, relative to the
+	 * default value; used if InitParams is not NULL.
+	 */
+
+	void init( CBiteRnd& rnd, const double* const InitParams = NULL,
+		const double InitRadius = 1.0 )
+	{
+		getMinValues( MinValues );
+		getMaxValues( MaxValues );
+
+		int i;
+
+		for( i = 0; i < ParamCount; i++ )
+		{
+			BestValues[ i ] = ( InitParams != NULL ? InitParams[ i ] :
+				MinValues[ i ] + ( MaxValues[ i ] - MinValues[ i ]) *
+				rnd.get() );
+		}
+
+		BestCost = optrank( BestValues );
+		LastCostPtr = &BestCost;
+		LastValuesPtr = BestValues;
+		EvalCount = 1;
+		StallCount = 0;
+
+		const uint64_t seed = rnd.getRaw();
+		int g;
+
+		for( g = 0; g < GroupCount; g++ )
+		{
+			CBiteOptCoopGroup* const G = Groups[ g ];
+
+			G -> rnd.initStream( seed, (uint64_t) g );
+			G -> EvalCount = 0;
+			G -> setContext( BestValues, BestCost );
+
+			G -> Opt.init( G -> rnd, ( InitParams != NULL ?
+				G -> BestParams : NULL ), InitRadius );
+		}
+	}
+
+	/**
+	 * Function performs an optimization cycle: each group takes a turn of
+	 * iterations, see setTurnIters().
+	 *
+	 * @return The number of cycles without improvement so far.
+	 */
+
+	int64_t optimize()
+	{
+		bool Improved = false;
+		int g;
+
+		if( ThreadCount == 1 || GroupCount == 1 )
+		{
+			for( g = 0; g < GroupCount; g++ )
+			{
+				CBiteOptCoopGroup* const G = Groups[ g ];
+
+				G -> setContext( BestValues, BestCost );
+				G -> run( TurnIters );
+
+				LastCostPtr = &G -> LastCost;
+				LastValuesPtr = G -> LastValues;
+
+				if( G -> BestCost < BestCost )
+				{
+					G -> unpack( G -> BestParams, BestValues );
+					BestCost = G -> BestCost;
+					Improved = true;
+				}
+			}
+		}
+		else
+		{
+			for( g = 0; g < GroupCount; g++ )
+			{
+				Groups[ g ] -> setContext( BestValues, BestCost );
+			}
+
+			runThreads();
+
+			Improved = mergeGroups();
+		}
+
+		StallCount = ( Improved ? 0 : StallCount + 1 );
+
+		return( StallCount );
+	}
+
+protected:
+	int ParamCount; ///< The total number of parameters.
+	int GroupCount; ///< The number of parameter groups.
+	CBiteOptCoopGroup** Groups; ///< Parameter groups.
+	int* GroupIdx; ///< Group index of each parameter.
+	int ThreadCount; ///< The number of threads to use.
+	int TurnIters; ///< The number of iterations of a group's turn.
+	double* BestValues; ///< Context vector, the best solution.
+	double BestCost; ///< Context vector's cost.
+	double* MergeValues; ///< Merged improvements, for concurrent turns.
+	double* TmpValues; ///< Temporary vector, for interaction checks.
+	double* MinValues; ///< Minimal parameter values.
+	double* MaxValues; ///< Maximal parameter values.
+	const double* LastCostPtr; ///< Cost of the latest evaluation.
+	const double* LastValuesPtr; ///< Parameter vector of the latest
+		///< evaluation.
+	int64_t EvalCount; ///< The number of evaluations performed by *this
+		///< object, excluding group evaluations.
+	int64_t StallCount; ///< The number of cycles without improvement.
+	double LearnEps; ///< Interaction threshold of learnGroups().
+	int LearnEvals; ///< The number of evaluations of learnGroups().
+
+	/**
+	 * Function performs group turns concurrently. Groups are distributed
+	 * between threads statically, and each group uses its own random number
+	 * generator, so that results do not depend on thread scheduling.
+	 */
+
+	void runThreads()
+	{
+		const int tc = ( ThreadCount < GroupCount ? ThreadCount :
+			GroupCount );
+
+		std :: thread* const Threads = new std :: thread[ tc - 1 ];
+		int t;
+
+		for( t = 1; t < tc; t++ )
+		{
+			Threads[ t - 1 ] = std :: thread( &CBiteOptCoop :: runGroups,
+				this, t, tc );
+		}
+
+		runGroups( 0, tc );
+
+		for( t = 1; t < tc; t++ )
+		{
+			Threads[ t - 1 ].join();
+		}
+
+		delete[] Threads;
+	}
+
+	/**
+	 * Function performs turns of groups assigned to a thread.
+	 *
+	 * @param t Thread index.
+	 * @param tc The number of threads.
+	 */
+
+	void runGroups( const int t, const int tc )
+	{
+		int g;
+
+		for( g = t; g < GroupCount; g += tc )
+		{
+			Groups[ g ] -> run( TurnIters );
+		}
+	}
+
+	/**
+	 * Function merges improvements of concurrent group turns into the
+	 * context vector. Improvements of all groups are combined, and the
+	 * combined vector is evaluated: it is accepted if it is better than the
+	 * best single-group improvement, which is accepted otherwise. For
+	 * separable groups, the combined vector's cost is expected to be the
+	 * lowest.
+	 *
+	 * @return "True" if the context vector was improved.
+	 */
+
+	bool mergeGroups()
+	{
+		memcpy( MergeValues, BestValues, ParamCount *
+			sizeof( MergeValues[ 0 ]));
+
+		int ImprCount = 0;
+		int bg = -1; // Group with the best improvement.
+		int g;
+
+		for( g = 0; g < GroupCount; g++ )
+		{
+			const CBiteOptCoopGroup* const G = Groups[ g ];
+
+			if( G -> BestCost < BestCost )
+			{
+				const int* const ai = G -> getActiveIdx();
+				const int ac = G -> getActiveCount();
+				int i;
+
+				for( i = 0; i < ac; i++ )
+				{
+					MergeValues[ ai[ i ]] = G -> BestParams[ i ];
+				}
+
+				if( bg < 0 || G -> BestCost < Groups[ bg ] -> BestCost )
+				{
+					bg = g;
+				}
+
+				ImprCount++;
+			}
+		}
+
+		LastCostPtr = &Groups[ GroupCount - 1 ] -> LastCost;
+		LastValuesPtr = Groups[ GroupCount - 1 ] -> LastValues;
+
+		if( ImprCount == 0 )
+		{
+			return( false );
+		}
+
+		const CBiteOptCoopGroup* const G = Groups[ bg ];
+
+		if( ImprCount > 1 )
+		{
+			const double mc = optrank( MergeValues );
+			EvalCount++;
+
+			if( mc < G -> BestCost )
+			{
+				memcpy( BestValues, MergeValues, ParamCount *
+					sizeof( BestValues[ 0 ]));
+
+				BestCost = mc;
+
+				return( true );
+			}
+		}
+
+		G -> unpack( G -> BestParams, BestValues );
+		BestCost = G -> BestCost;
+
+		return( true );
+	}
+
+	/**
+	 * Function finds parameters that interact with the current component,
+	 * by recursive bisection. Interacting parameters are moved to the
+	 * beginning of the "v" array.
+	 *
+	 * @param v Parameter indices to check.
+	 * @param vc The number of parameter indices.
+	 * @param UpValues Vector with component's parameters at maximal values,
+	 * and other parameters at minimal values.
+	 * @param fll Cost of the vector with all parameters at minimal values.
+	 * @param ful Cost of the UpValues vector.
+	 * @return The number of interacting parameters found.
+	 */
+
+	int findInteract( int* const v, const int vc,
+		const double* const UpValues, const double fll, const double ful )
+	{
+		if( vc == 0 )
+		{
+			return( 0 );
+		}
+
+		int i;
+
+		memcpy( TmpValues, MinValues, ParamCount * sizeof( TmpValues[ 0 ]));
+
+		for( i = 0; i < vc; i++ )
+		{
+			const int k = v[ i ];
+			TmpValues[ k ] = 0.5 * ( MinValues[ k ] + MaxValues[ k ]);
+		}
+
+		const double flm = optcost( TmpValues );
+
+		memcpy( TmpValues, UpValues, ParamCount * sizeof( TmpValues[ 0 ]));
+
+		for( i = 0; i < vc; i++ )
+		{
+			const int k = v[ i ];
+			TmpValues[ k ] = 0.5 * ( MinValues[ k ] + MaxValues[ k ]);
+		}
+
+		const double fum = optcost( TmpValues );
+		LearnEvals += 2;
+
+		const double d = fabs(( fll - ful ) - ( flm - fum ));
+		const double m = fabs( fll ) + fabs( ful ) + fabs( flm ) +
+			fabs( fum );
+
+		if( !( d > LearnEps * m ))
+		{
+			return( 0 );
+		}
+
+		if( vc == 1 )
+		{
+			return( 1 );
+		}
+
+		const int h = vc >> 1;
+		const int c1 = findInteract( v, h, UpValues, fll, ful );
+		const int c2 = findInteract( v + h, vc - h, UpValues, fll, ful );
+
+		// Move interacting parameters of the second half next to the ones
+		// of the first half.
+
+		for( i = 0; i < c2; i++ )
+		{
+			const int t = v[ c1 + i ];
+			v[ c1 + i ] = v[ h + i ];
+			v[ h + i ] = t;
+		}
+
+		return( c1 + c2 );
+	}
+
+	void deleteGroups()
+	{
+		int g;
+
+		for( g = 0; g < GroupCount; g++ )
+		{
+			delete Groups[ g ];
+		}
+
+		delete[] Groups;
+		Groups = NULL;
+		GroupCount = 0;
+	}
+
+	void deleteBuffers()
+	{
+		delete[] GroupIdx;
+		delete[] BestValues;
+		delete[] MergeValues;
+		delete[] TmpValues;
+		delete[] MinValues;
+		delete[] MaxValues;
+	}
+};
+
+#endif // BITEOPTCC_INCLUDED
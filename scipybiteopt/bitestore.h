@@ -0,0 +1,649 @@
+//$ nocpp
+
+/**
+ * @file bitestore.h
+ *
+ * @version 2024.6
+ *
+ * @brief The inclusion file for the CBiteStore class.
+ *
+ * @section license License
+ *
+ * Copyright (c) 2016-2024 Aleksey Vaneev
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef BITESTORE_INCLUDED
+#define BITESTORE_INCLUDED
+
+#include "biteaux.h"
+
+#if !defined( _WIN32 )
+	#include <errno.h>
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif // !defined( _WIN32 )
+
+/**
+ * Persistent evaluation store class. Holds objective function values in a
+ * memory-mapped file, so that they can be reused across optimization runs,
+ * and shared by concurrent processes and threads. Values are keyed by the
+ * problem fingerprint (the number of parameters, bounds and a user tag), and
+ * by the exact bit pattern of the parameter vector.
+ *
+ * The file contains a fixed-size open addressing hash table with linear
+ * probing. When there is no free slot within the probing limit, a ready slot
+ * of the probed range is evicted, and overwritten with the new value. Each
+ * slot has a state word: its lower 2 bits hold the state (0 - empty, 1 -
+ * being written, 2 - ready), and its upper bits hold the slot's generation,
+ * incremented on each eviction. A writer claims a slot via compare-and-swap,
+ * fills it, and publishes it with a release store. Readers only access slots
+ * they observed as ready, and discard the read if the state word changed
+ * meanwhile (a sequence lock). Lookups and inserts are thus lock-free.
+ *
+ * Crash behavior: a new file is created and initialized under a temporary
+ * name, and is then linked to the requested name, so that other processes
+ * never observe a partially-initialized file. A file without a valid header
+ * (e.g., truncated) is replaced with a new empty file. A process that
+ * terminates while writing a slot leaves it in the "being written" state;
+ * such slots are skipped by lookups and inserts, and are never reused.
+ * Values that were published before a crash remain valid.
+ *
+ * The store is available on POSIX systems only, on other systems the open()
+ * function returns "false".
+ */
+
+class CBiteStore
+{
+public:
+	CBiteStore()
+		: Map( NULL )
+		, MapSize( 0 )
+		, HitCount( 0 )
+		, MissCount( 0 )
+		, EvictCount( 0 )
+	{
+	}
+
+	~CBiteStore()
+	{
+		close();
+	}
+
+	/**
+	 * Function opens or creates a store file. If the file exists, its
+	 * parameter count should match. Does nothing and returns "false", if the
+	 * store is already open.
+	 *
+	 * @param FileName Store file name.
+	 * @param aParamCount The number of parameters in the objective function.
+	 * @param lb Lower bounds of parameters.
+	 * @param ub Upper bounds of parameters.
+	 * @param Tag User tag that identifies the objective function, can be
+	 * NULL.
+	 * @param SlotCount0 The number of slots to allocate when the file is
+	 * created, rounded up to a power of 2. Bounds the number of values the
+	 * store holds.
+	 * @return "True" if the store was opened successfully.
+	 */
+
+	bool open( const char* const FileName, const int aParamCount,
+		const double* const lb, const double* const ub,
+		const char* const Tag = NULL, const int SlotCount0 = 65536 )
+	{
+	#if defined( _WIN32 )
+
+		return( false );
+
+	#else // defined( _WIN32 )
+
+		if( Map != NULL || aParamCount < 1 )
+		{
+			return( false );
+		}
+
+		ParamCount = aParamCount;
+		SlotSize = sizeof( CSlotHdr ) + ParamCount * sizeof( double );
+		Fingerprint = calcFingerprint( lb, ub, Tag );
+		HitCount = 0;
+		MissCount = 0;
+		EvictCount = 0;
+
+		int i;
+
+		for( i = 0; i < 4; i++ )
+		{
+			const int fd = ::open( FileName, O_RDWR );
+
+			if( fd < 0 )
+			{
+				if( errno != ENOENT )
+				{
+					return( false );
+				}
+
+				const int r = createFile( FileName, SlotCount0, false );
+
+				if( r != 0 )
+				{
+					return( r > 0 );
+				}
+
+				continue; // Created by a concurrent process, open it.
+			}
+
+			CFileHdr h;
+			struct stat st;
+
+			if( pread( fd, &h, sizeof( h ), 0 ) != (ssize_t) sizeof( h ) ||
+				h.Magic != FileMagic )
+			{
+				// Partially-initialized or truncated file, replace it.
+
+				::close( fd );
+
+				return( createFile( FileName, SlotCount0, true ) > 0 );
+			}
+
+			if( h.Version != FileVersion ||
+				h.ParamCount != (uint32_t) ParamCount || h.SlotCount < 16 ||
+				( h.SlotCount & ( h.SlotCount - 1 )) != 0 ||
+				fstat( fd, &st ) != 0 )
+			{
+				::close( fd );
+				return( false );
+			}
+
+			SlotCount = (int) h.SlotCount;
+			MapSize = sizeof( CFileHdr ) + (size_t) SlotCount * SlotSize;
+
+			const bool IsMapped = ( (size_t) st.st_size == MapSize &&
+				mapFile( fd ));
+
+			::close( fd );
+
+			return( IsMapped );
+		}
+
+		return( false );
+
+	#endif // defined( _WIN32 )
+	}
+
+	/**
+	 * Function closes the store file. The file is not removed.
+	 */
+
+	void close()
+	{
+	#if !defined( _WIN32 )
+
+		if( Map != NULL )
+		{
+			munmap( Map, MapSize );
+			Map = NULL;
+		}
+
+	#endif // !defined( _WIN32 )
+	}
+
+	/**
+	 * @return "True" if the store is open.
+	 */
+
+	bool isOpen() const
+	{
+		return( Map != NULL );
+	}
+
+	/**
+	 * Function looks up the specified parameter vector, and updates hit or
+	 * miss counter.
+	 *
+	 * @param Params Parameter vector.
+	 * @param[out] Cost Stored objective function value, if found.
+	 * @return "True" if the vector was found.
+	 */
+
+	bool find( const double* const Params, double& Cost )
+	{
+		const uint64_t h = calcHash( Params );
+		size_t i = (size_t) h;
+		int k;
+
+		for( k = 0; k < MaxProbeCount; k++, i++ )
+		{
+			CSlotHdr* const s = getSlot( i );
+			const uint32_t st = __atomic_load_n( &s -> State,
+				__ATOMIC_ACQUIRE );
+
+			if( st == StateEmpty )
+			{
+				break;
+			}
+
+			if(( st & StateMask ) == StateReady && isMatch( s, h, Params ))
+			{
+				const double c = s -> Cost;
+
+				// Discard the value if the slot was evicted while reading.
+
+				__atomic_thread_fence( __ATOMIC_ACQUIRE );
+
+				if( __atomic_load_n( &s -> State, __ATOMIC_RELAXED ) == st )
+				{
+					HitCount++;
+					Cost = c;
+
+					return( true );
+				}
+			}
+		}
+
+		MissCount++;
+
+		return( false );
+	}
+
+	/**
+	 * Function stores an objective function value of the specified parameter
+	 * vector. Function does nothing if the vector is already stored. If there
+	 * is no free slot within the probing limit, a ready slot is evicted.
+	 *
+	 * @param Params Parameter vector.
+	 * @param Cost Objective function value.
+	 */
+
+	void insert( const double* const Params, const double Cost )
+	{
+		const uint64_t h = calcHash( Params );
+		size_t i = (size_t) h;
+		size_t ei = 0;
+		uint32_t est = StateEmpty; // State of the eviction candidate.
+		int k;
+
+		for( k = 0; k < MaxProbeCount; k++, i++ )
+		{
+			CSlotHdr* const s = getSlot( i );
+			uint32_t st = __atomic_load_n( &s -> State, __ATOMIC_ACQUIRE );
+
+			if( st == StateEmpty )
+			{
+				if( __atomic_compare_exchange_n( &s -> State, &st,
+					StateWriting, false, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE ))
+				{
+					writeSlot( s, h, Params, Cost, StateReady );
+					return;
+				}
+
+				// "st" was updated by a failed compare-and-swap.
+			}
+
+			if(( st & StateMask ) == StateReady )
+			{
+				if( isMatch( s, h, Params ))
+				{
+					return;
+				}
+
+				// Rotate eviction candidates over the probed range.
+
+				if( est == StateEmpty ||
+					k == (int) ( EvictCount % MaxProbeCount ))
+				{
+					ei = i;
+					est = st;
+				}
+			}
+		}
+
+		if( est == StateEmpty )
+		{
+			return;
+		}
+
+		EvictCount++;
+
+		CSlotHdr* const s = getSlot( ei );
+		const uint32_t g = ( est & ~StateMask ) + StateMask + 1;
+
+		if( __atomic_compare_exchange_n( &s -> State, &est,
+			g | StateWriting, false, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE ))
+		{
+			__atomic_thread_fence( __ATOMIC_RELEASE );
+			writeSlot( s, h, Params, Cost, g | StateReady );
+		}
+	}
+
+	/**
+	 * @return The number of values evicted by insert() calls, since the
+	 * open() call.
+	 */
+
+	int64_t getEvictCount() const
+	{
+		return( EvictCount );
+	}
+
+	/**
+	 * @return The number of lookups that found a stored value, since the
+	 * open() call.
+	 */
+
+	int64_t getHitCount() const
+	{
+		return( HitCount );
+	}
+
+	/**
+	 * @return The number of lookups that did not find a stored value, since
+	 * the open() call.
+	 */
+
+	int64_t getMissCount() const
+	{
+		return( MissCount );
+	}
+
+protected:
+	static const uint64_t FileMagic = 0x524F545345544942; ///< "BITESTOR",
+		///< little-endian.
+	static const uint32_t FileVersion = 2; ///< File format version.
+	static const uint32_t StateEmpty = 0; ///< Slot state: empty.
+	static const uint32_t StateWriting = 1; ///< Slot state: being written.
+	static const uint32_t StateReady = 2; ///< Slot state: ready.
+	static const uint32_t StateMask = 3; ///< Mask of state bits in the state
+		///< word, the remaining bits hold the slot's generation.
+	static const int MaxProbeCount = 64; ///< The maximal number of slots to
+		///< probe.
+
+	/**
+	 * File header structure.
+	 */
+
+	struct CFileHdr
+	{
+		uint64_t Magic; ///< File magic value, written last.
+		uint32_t Version; ///< File format version.
+		uint32_t ParamCount; ///< The number of parameters in a slot.
+		uint64_t SlotCount; ///< The number of slots, a power of 2.
+		uint64_t Reserved[ 5 ]; ///< Reserved, zero.
+	};
+
+	/**
+	 * Slot header structure, followed by ParamCount parameter values.
+	 */
+
+	struct CSlotHdr
+	{
+		uint32_t State; ///< Slot state word.
+		uint32_t Reserved; ///< Reserved, zero.
+		uint64_t Hash; ///< Hash value of the fingerprint and parameters.
+		uint64_t Fingerprint; ///< Problem fingerprint.
+		double Cost; ///< Objective function value.
+	};
+
+	uint8_t* Map; ///< Mapped file, NULL if not open.
+	size_t MapSize; ///< Mapped file's size.
+	int ParamCount; ///< The number of parameters.
+	int SlotCount; ///< The number of slots in the file.
+	size_t SlotSize; ///< Size of a slot, in bytes.
+	uint64_t Fingerprint; ///< Fingerprint of the current problem.
+	int64_t HitCount; ///< The number of store hits.
+	int64_t MissCount; ///< The number of store misses.
+	int64_t EvictCount; ///< The number of evicted values.
+
+	/**
+	 * Function creates a new store file under a temporary name, initializes
+	 * and maps it, and then links it to the specified file name.
+	 *
+	 * @param FileName Store file name.
+	 * @param SlotCount0 The number of slots to allocate.
+	 * @param DoReplace "True" if an existing file should be replaced,
+	 * "false" if the file should be created only if it does not exist.
+	 * @return 1 if the file was created and mapped, 0 if the file was
+	 * created concurrently by another process, -1 on error.
+	 */
+
+	int createFile( const char* const FileName, const int SlotCount0,
+		const bool DoReplace )
+	{
+	#if defined( _WIN32 )
+
+		return( -1 );
+
+	#else // defined( _WIN32 )
+
+		const size_t fl = strlen( FileName );
+		char* const tn = new char[ fl + 8 ];
+		memcpy( tn, FileName, fl );
+		memcpy( tn + fl, ".XXXXXX", 8 );
+
+		const int fd = mkstemp( tn );
+
+		if( fd < 0 )
+		{
+			delete[] tn;
+			return( -1 );
+		}
+
+		fchmod( fd, 0644 );
+
+		SlotCount = 16;
+
+		while( SlotCount < SlotCount0 )
+		{
+			SlotCount <<= 1;
+		}
+
+		MapSize = sizeof( CFileHdr ) + (size_t) SlotCount * SlotSize;
+
+		if( ftruncate( fd, (off_t) MapSize ) != 0 || !mapFile( fd ))
+		{
+			::close( fd );
+			unlink( tn );
+			delete[] tn;
+
+			return( -1 );
+		}
+
+		::close( fd );
+
+		CFileHdr* const h = (CFileHdr*) Map;
+		h -> Version = FileVersion;
+		h -> ParamCount = (uint32_t) ParamCount;
+		h -> SlotCount = (uint64_t) SlotCount;
+		h -> Magic = FileMagic;
+
+		int r = 1;
+
+		if( DoReplace )
+		{
+			if( rename( tn, FileName ) != 0 )
+			{
+				r = -1;
+			}
+		}
+		else
+		{
+			if( link( tn, FileName ) != 0 )
+			{
+				r = ( errno == EEXIST ? 0 : -1 );
+			}
+
+			unlink( tn );
+		}
+
+		if( r != 1 )
+		{
+			if( DoReplace )
+			{
+				unlink( tn );
+			}
+
+			close();
+		}
+
+		delete[] tn;
+
+		return( r );
+
+	#endif // defined( _WIN32 )
+	}
+
+	/**
+	 * Function writes a value to a slot claimed by the caller, and publishes
+	 * the slot.
+	 *
+	 * @param s Slot pointer.
+	 * @param h Hash value of the parameter vector.
+	 * @param Params Parameter vector.
+	 * @param Cost Objective function value.
+	 * @param NewState New state word of the slot.
+	 */
+
+	void writeSlot( CSlotHdr* const s, const uint64_t h,
+		const double* const Params, const double Cost,
+		const uint32_t NewState )
+	{
+		s -> Hash = h;
+		s -> Fingerprint = Fingerprint;
+		s -> Cost = Cost;
+		memcpy( s + 1, Params, ParamCount * sizeof( Params[ 0 ]));
+
+		__atomic_store_n( &s -> State, NewState, __ATOMIC_RELEASE );
+	}
+
+	/**
+	 * Function maps the whole file into memory.
+	 *
+	 * @param fd File descriptor.
+	 * @return "True" on success.
+	 */
+
+	bool mapFile( const int fd )
+	{
+	#if defined( _WIN32 )
+
+		return( false );
+
+	#else // defined( _WIN32 )
+
+		void* const p = mmap( NULL, MapSize, PROT_READ | PROT_WRITE,
+			MAP_SHARED, fd, 0 );
+
+		if( p == MAP_FAILED )
+		{
+			return( false );
+		}
+
+		Map = (uint8_t*) p;
+
+		return( true );
+
+	#endif // defined( _WIN32 )
+	}
+
+	/**
+	 * Function returns a pointer to the specified slot.
+	 *
+	 * @param i Slot index, wrapped to the slot count.
+	 */
+
+	CSlotHdr* getSlot( const size_t i ) const
+	{
+		return( (CSlotHdr*) ( Map + sizeof( CFileHdr ) +
+			( i & ( SlotCount - 1 )) * SlotSize ));
+	}
+
+	/**
+	 * Function returns "true" if the specified ready slot holds the specified
+	 * parameter vector of the current problem.
+	 */
+
+	bool isMatch( const CSlotHdr* const s, const uint64_t h,
+		const double* const Params ) const
+	{
+		return( s -> Hash == h && s -> Fingerprint == Fingerprint &&
+			memcmp( s + 1, Params, ParamCount * sizeof( Params[ 0 ])) == 0 );
+	}
+
+	/**
+	 * Function calculates a hash value of a memory block, continuing from
+	 * the specified hash value.
+	 */
+
+	static uint64_t calcHashBuf( uint64_t h, const void* const p,
+		const size_t l )
+	{
+		const uint8_t* const b = (const uint8_t*) p;
+		size_t i;
+
+		for( i = 0; i + 8 <= l; i += 8 )
+		{
+			uint64_t v;
+			memcpy( &v, b + i, 8 );
+			h = CBiteRnd :: mix64( h ^ v );
+		}
+
+		uint64_t v = l;
+
+		for( ; i < l; i++ )
+		{
+			v = ( v << 8 ) | b[ i ];
+		}
+
+		return( CBiteRnd :: mix64( h ^ v ) + 0x9E3779B97F4A7C15 );
+	}
+
+	/**
+	 * Function calculates problem fingerprint.
+	 */
+
+	uint64_t calcFingerprint( const double* const lb, const double* const ub,
+		const char* const Tag ) const
+	{
+		uint64_t h = CBiteRnd :: mix64( (uint64_t) ParamCount );
+		h = calcHashBuf( h, lb, ParamCount * sizeof( lb[ 0 ]));
+		h = calcHashBuf( h, ub, ParamCount * sizeof( ub[ 0 ]));
+
+		if( Tag != NULL )
+		{
+			h = calcHashBuf( h, Tag, strlen( Tag ));
+		}
+
+		return( h );
+	}
+
+	/**
+	 * Function calculates hash value of the specified parameter vector of
+	 * the current problem.
+	 */
+
+	uint64_t calcHash( const double* const Params ) const
+	{
+		return( calcHashBuf( Fingerprint, Params,
+			ParamCount * sizeof( Params[ 0 ])));
+	}
+};
+
+#endif // BITESTORE_INCLUDED
@@ -50,6 +50,7 @@ public:
 		: y( NULL )
 		, x2( NULL )
 	{
+		TierPopSize = 0; // "x" is an alias of PopParams.
 	}
 
 	virtual ~CNMSeqOpt()
@@ -140,7 +141,7 @@ public:
 	 * @return The number of non-improving iterations so far.
 	 */
 
-	int optimize( CBiteRnd& rnd )
+	int64_t optimize( CBiteRnd& rnd )
 	{
 		int i;
 
@@ -335,10 +336,14 @@ private:
 			aObjCount );
 
 		x = PopParams;
-		y = new double[ M ];
 		x0 = CentParams;
 		x1 = TmpParams;
-		x2 = new double[ N ];
+
+		if( !BufReused )
+		{
+			y = new double[ M ];
+			x2 = new double[ N ];
+		}
 	}
 
 	virtual void deleteBuffers()
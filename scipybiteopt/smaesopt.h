@@ -160,7 +160,7 @@ public:
 	 * @return The number of non-improving iterations so far.
 	 */
 
-	int optimize( CBiteRnd& rnd )
+	int64_t optimize( CBiteRnd& rnd )
 	{
 		double* const Params = getCurParams();
 
@@ -47,6 +47,7 @@ public:
 	CSpherOpt()
 		: WPopCent( NULL )
 		, WPopRad( NULL )
+		, WPopSize( 0 )
 	{
 		addSel( CentPowSel, "CentPowSel" );
 		addSel( RadPowSel, "RadPowSel" );
@@ -99,6 +100,7 @@ public:
 
 		Radius = 0.5 * InitRadius;
 		EvalFac = 2.0;
+		EvalFacIdx = 1;
 		cure = 0;
 		curem = (int) ceil( CurPopSize * EvalFac );
 
@@ -133,7 +135,7 @@ public:
 	 * @return The number of non-improving iterations so far.
 	 */
 
-	int optimize( CBiteRnd& rnd )
+	int64_t optimize( CBiteRnd& rnd )
 	{
 		double* const Params = getCurParams();
 		int i;
@@ -152,9 +154,11 @@ public:
 		{
 			double s2 = 1e-300;
 
+			rnd.fillUniform( Params, ParamCount );
+
 			for( i = 0; i < ParamCount; i++ )
 			{
-				Params[ i ] = rnd.get() - 0.5;
+				Params[ i ] -= 0.5;
 				s2 += Params[ i ] * Params[ i ];
 			}
 
@@ -223,12 +227,23 @@ public:
 	}
 
 protected:
-	double* WPopCent; ///< Weighting coefficients for centroid.
-	double* WPopRad; ///< Weighting coefficients for radius.
+	static const int WCount = 12; ///< The number of cached coefficient
+		///< vectors, for all EvalFac and power factor index pairs.
+	double* WPopCent; ///< Weighting coefficients for centroid, WCount
+		///< vectors of PopSize elements, see getWeights().
+	double* WPopRad; ///< Weighting coefficients for radius, WCount vectors
+		///< of PopSize elements.
+	double WCentSums[ WCount ]; ///< Reciprocals of WPopCent vectors' sums, 0
+		///< if a vector was not yet calculated.
+	double WRadSums[ WCount ]; ///< Reciprocals of WPopRad vectors' sums, 0
+		///< if a vector was not yet calculated.
+	int WPopSize; ///< CurPopSize the coefficients were calculated for, 0 if
+		///< none.
 	double JitMult; ///< Jitter multiplier.
 	double JitOffs; ///< Jitter multiplier offset.
 	double Radius; ///< Current radius.
 	double EvalFac; ///< Evaluations factor.
+	int EvalFacIdx; ///< Index of EvalFac, in the update() function's table.
 	int cure; ///< Current evaluation index.
 	int curem; ///< "cure" value threshold.
 	CBiteSel< 4 > CentPowSel; ///< Centroid power factor selector.
@@ -241,8 +256,15 @@ protected:
 		CBiteOptBase< double > :: initBuffers( aParamCount, aPopSize,
 			aCnsCount, aObjCount );
 
-		WPopCent = new double[ aPopSize ];
-		WPopRad = new double[ aPopSize ];
+		WPopSize = 0;
+
+		if( BufReused )
+		{
+			return;
+		}
+
+		WPopCent = new double[ WCount * aPopSize ];
+		WPopRad = new double[ WCount * aPopSize ];
 	}
 
 	virtual void deleteBuffers()
@@ -253,6 +275,47 @@ protected:
 		delete[] WPopRad;
 	}
 
+	/**
+	 * Function returns a vector of weighting coefficients of the update()
+	 * function, and calculates it on first use. The coefficients depend on
+	 * the power factor, and on "curem", which is defined by EvalFacIdx, so
+	 * all of them are cached, until CurPopSize changes.
+	 *
+	 * @param WBuf Coefficient buffer, WPopCent or WPopRad.
+	 * @param WSums Reciprocals of coefficient vectors' sums, WCentSums or
+	 * WRadSums.
+	 * @param pi Power factor index (0-3).
+	 * @param p Power factor.
+	 * @param[out] s Receives the reciprocal of the coefficients' sum.
+	 */
+
+	const double* getWeights( double* const WBuf, double* const WSums,
+		const int pi, const double p, double& s )
+	{
+		const int k = EvalFacIdx * 4 + pi;
+		double* const w = WBuf + k * PopSize;
+
+		if( WSums[ k ] == 0.0 )
+		{
+			const double lm = 1.0 / curem;
+			double sw = 0.0;
+			int i;
+
+			for( i = 0; i < CurPopSize; i++ )
+			{
+				const double v = pow( 1.0 - i * lm, p );
+				w[ i ] = v;
+				sw += v;
+			}
+
+			WSums[ k ] = 1.0 / sw;
+		}
+
+		s = WSums[ k ];
+
+		return( w );
+	}
+
 	/**
 	 * Function updates centroid and radius.
 	 *
@@ -265,34 +328,31 @@ protected:
 		static const double WRad[ 4 ] = { 14.0, 16.0, 18.0, 20.0 };
 		static const double EvalFacs[ 3 ] = { 2.1, 2.0, 1.9 };
 
-		const double CentFac = WCent[ select( CentPowSel, rnd )];
-		const double RadFac = WRad[ select( RadPowSel, rnd )];
-		EvalFac = EvalFacs[ select( EvalFacSel, rnd )];
+		if( WPopSize != CurPopSize )
+		{
+			memset( WCentSums, 0, sizeof( WCentSums ));
+			memset( WRadSums, 0, sizeof( WRadSums ));
+			WPopSize = CurPopSize;
+		}
 
-		const double lm = 1.0 / curem;
-		double s1 = 0.0;
-		double s2 = 0.0;
-		int i;
+		const int ci = select( CentPowSel, rnd );
+		const int ri = select( RadPowSel, rnd );
 
-		for( i = 0; i < CurPopSize; i++ )
-		{
-			const double l = 1.0 - i * lm;
+		double s1;
+		double s2;
+		const double* const wc = getWeights( WPopCent, WCentSums, ci,
+			WCent[ ci ], s1 );
 
-			const double v1 = pow( l, CentFac );
-			WPopCent[ i ] = v1;
-			s1 += v1;
+		const double* const rc = getWeights( WPopRad, WRadSums, ri,
+			WRad[ ri ], s2 );
 
-			const double v2 = pow( l, RadFac );
-			WPopRad[ i ] = v2;
-			s2 += v2;
-		}
+		EvalFacIdx = select( EvalFacSel, rnd );
+		EvalFac = EvalFacs[ EvalFacIdx ];
 
-		s1 = 1.0 / s1;
-		s2 = 1.0 / s2;
+		int i;
 
-		const double* ip = PopParams[ 0 ];
+		const double* ip = getParamsOrdered( 0 );
 		double* const cp = CentParams;
-		const double* const wc = WPopCent;
 		double w = wc[ 0 ] * s1;
 
 		for( i = 0; i < ParamCount; i++ )
@@ -304,7 +364,7 @@ protected:
 
 		for( j = 1; j < CurPopSize; j++ )
 		{
-			ip = PopParams[ j ];
+			ip = getParamsOrdered( j );
 			w = wc[ j ] * s1;
 
 			for( i = 0; i < ParamCount; i++ )
@@ -313,12 +373,11 @@ protected:
 			}
 		}
 
-		const double* const rc = WPopRad;
 		Radius = 0.0;
 
 		for( j = 0; j < CurPopSize; j++ )
 		{
-			ip = PopParams[ j ];
+			ip = getParamsOrdered( j );
 			double s = 0.0;
 
 			for( i = 0; i < ParamCount; i++ )
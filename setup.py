@@ -15,15 +15,22 @@ headers = ['scipybiteopt/biteopt.h',
             'scipybiteopt/biteoptort.h',
             'scipybiteopt/spheropt.h',
             'scipybiteopt/biteaux.h',
-            'scipybiteopt/nmsopt.h']
+            'scipybiteopt/nmsopt.h',
+            'scipybiteopt/bitestore.h',
+            'scipybiteopt/bitelog.h',
+            'scipybiteopt/biteoptcc.h']
 
 def get_c_sources(files, include_headers=False):
     return files + (headers if include_headers else [])
 
+# BITEOPT_STATS=1 compiles in hot-path counters, see scipybiteopt.engine_stats()
+define_macros = [('BITEOPT_STATS', '1')] if os.environ.get('BITEOPT_STATS', '0') not in ('', '0') else []
+
 module1 = Extension('scipybiteopt.biteopt',
                   sources=get_c_sources(['scipybiteopt/biteopt_py_ext.cpp'], include_headers=(sys.argv[1] == "sdist")),
                   language="c++",
                   include_dirs=[numpy.get_include()],
+                  define_macros=define_macros,
                   extra_compile_args=['-std=c++11',  '-O3'] if os.name != 'nt' else ['-O3'])
 
 setup(name='scipybiteopt',